@@ -0,0 +1,226 @@
+///////////////////////////////////////////////////////////////////////////
+// LibSBTL_vu_N2 - SBTL library for gaseous nitrogen based on:
+//
+// Span, R., Lemmon, E.W., Jacobsen, R.T, Wagner, W., and Yokozeki, A.:
+//
+//   "A Reference Equation of State for the Thermodynamic Properties of Nitrogen for Temperatures
+//   from 63.151 to 1000 K and Pressures to 2200 MPa," J. Phys. Chem. Ref. Data, 29(6):1361-1433,
+//   2000.
+//
+// Lemmon, E.W. and Jacobsen, R.T.:
+//
+//   "Viscosity and Thermal Conductivity Equations for Nitrogen, Oxygen, Argon, and Air"
+//   Int. J. Thermophys., 25:21-69, 2004.
+//
+// Copyright (C) Idaho National Laboratory.
+// All rights reserved.
+//
+// Disclaimer:
+// The Idaho National Laboratory (INL) uses its best efforts to deliver a high-quality software and
+// to verify that the computed information is correct. However, INL makes no warranties to that
+// effect, and INL shall not be liable for any damage that may result from errors or omissions in
+// the software.
+//
+// Version: 0.9.0
+//
+// ALL_VU_N2 - all forward properties with derivatives from a single cell search
+//
+///////////////////////////////////////////////////////////////////////////
+//
+#include "math.h"
+#include "SBTL_N2.h"
+#include "SBTL_call_conv.h"
+#include "VU_N2.h"
+//
+// forward spline tables in the order of the IALL_* indices
+static const int itab_ALL_VUN2[NALL_VU_N2] = {ITAB_PVUN2,
+                                              ITAB_TVUN2,
+                                              ITAB_SVUN2,
+                                              ITAB_WVUN2,
+                                              ITAB_CPVUN2,
+                                              ITAB_CVVUN2,
+                                              ITAB_ETAVUN2,
+                                              ITAB_LAMBDAVUN2};
+//
+// all properties of cell (i,j)
+static inline void
+DIFF_ALL_VU_N2_IJ(unsigned int i,
+                  unsigned int j,
+                  double dx1,
+                  double dx2,
+                  double v,
+                  double * z,
+                  double * dzdv,
+                  double * dzdu) throw()
+{
+  double dzdx1;
+  const double v_inv = 1. / v;
+  for (int k = 0; k < NALL_VU_N2; k++)
+  {
+    const SBTL_COEF_N2 * val = CELL_VU_N2(SBTL_TAB_N2[itab_ALL_VUN2[k]], i, j);
+    DIFF_SPLINE_VU_N2(val, dx1, dx2, z[k], dzdx1, dzdu[k]);
+    // consider transformations
+    dzdv[k] = dzdx1 * v_inv;
+  }
+}
+//
+// z[k], dzdv[k] = (dz/dv)_u and dzdu[k] = (dz/du)_v for all properties k = IALL_*
+SBTLAPI void __stdcall DIFF_ALL_VU_N2_T(
+    double vt, double v, double u, double * z, double * dzdv, double * dzdu) throw()
+{
+  unsigned int i, j;
+  double dx1, dx2;
+
+  IJ_VU_N2_T_INL(vt, u, i, j, dx1, dx2);
+  DIFF_ALL_VU_N2_IJ(i, j, dx1, dx2, v, z, dzdv, dzdu);
+}
+//
+// DIFF_ALL_VU_N2_T with the cell hint 'cell' (CELL_NONE_N2 on the first call)
+SBTLAPI void __stdcall DIFF_ALL_VU_N2_H(double vt,
+                                        double v,
+                                        double u,
+                                        unsigned int & cell,
+                                        double * z,
+                                        double * dzdv,
+                                        double * dzdu) throw()
+{
+  unsigned int i, j;
+  double dx1, dx2;
+
+  IJ_VU_N2_T_HINT_INL(vt, u, cell, i, j, dx1, dx2);
+  DIFF_ALL_VU_N2_IJ(i, j, dx1, dx2, v, z, dzdv, dzdu);
+}
+//
+SBTLAPI void __stdcall DIFF_ALL_VU_N2(
+    double v, double u, double * z, double * dzdv, double * dzdu) throw()
+{
+  DIFF_ALL_VU_N2_T(log(v), v, u, z, dzdv, dzdu);
+}
+//
+// p and the property z of table itab with their derivatives w.r.t. x1 = vt times v_inv and w.r.t. u
+static inline void
+DIFF_PZ_VU_N2_INL(int itab,
+                  double vt,
+                  double v_inv,
+                  double u,
+                  double & p,
+                  double & dpdv,
+                  double & dpdu,
+                  double & z,
+                  double & dzdv,
+                  double & dzdu) throw()
+{
+  unsigned int i, j;
+  double dx1, dx2, dzdx1;
+
+  IJ_VU_N2_T_INL(vt, u, i, j, dx1, dx2);
+  DIFF_SPLINE_VU_N2(CELL_VU_N2(SBTL_TAB_N2[ITAB_PVUN2], i, j), dx1, dx2, p, dzdx1, dpdu);
+  dpdv = dzdx1 * v_inv;
+  DIFF_SPLINE_VU_N2(CELL_VU_N2(SBTL_TAB_N2[itab], i, j), dx1, dx2, z, dzdx1, dzdu);
+  dzdv = dzdx1 * v_inv;
+}
+//
+// p and t with their derivatives (as DIFF_P_VU_N2_T and DIFF_T_VU_N2_T) from a single cell search
+SBTLAPI void __stdcall DIFF_PT_VU_N2_T(double vt,
+                                      double v,
+                                      double u,
+                                      double & p,
+                                      double & dpdv,
+                                      double & dpdu,
+                                      double & t,
+                                      double & dtdv,
+                                      double & dtdu) throw()
+{
+  DIFF_PZ_VU_N2_INL(ITAB_TVUN2, vt, 1. / v, u, p, dpdv, dpdu, t, dtdv, dtdu);
+}
+//
+// DIFF_PT_VU_N2_T with the derivatives w.r.t. vt instead of v (as DIFF_P_VU_N2_TT and
+// DIFF_T_VU_N2_TT), for Newton's method in (vt,u)
+SBTLAPI void __stdcall DIFF_PT_VU_N2_TT(double vt,
+                                       double u,
+                                       double & p,
+                                       double & dpdv,
+                                       double & dpdu,
+                                       double & t,
+                                       double & dtdv,
+                                       double & dtdu) throw()
+{
+  DIFF_PZ_VU_N2_INL(ITAB_TVUN2, vt, 1., u, p, dpdv, dpdu, t, dtdv, dtdu);
+}
+//
+// p and s with their derivatives w.r.t. vt and u (as DIFF_P_VU_N2_TT and DIFF_S_VU_N2_TT) from a
+// single cell search, for Newton's method in (vt,u)
+SBTLAPI void __stdcall DIFF_PS_VU_N2_TT(double vt,
+                                       double u,
+                                       double & p,
+                                       double & dpdv,
+                                       double & dpdu,
+                                       double & s,
+                                       double & dsdv,
+                                       double & dsdu) throw()
+{
+  DIFF_PZ_VU_N2_INL(ITAB_SVUN2, vt, 1., u, p, dpdv, dpdu, s, dsdv, dsdu);
+}
+//
+//-----------------------------------------------------------------------------
+// single properties of the tables in use
+//-----------------------------------------------------------------------------
+//
+// The single property functions P_VU_N2, DIFF_P_VU_N2_T etc. evaluate the arrays compiled into the
+// library. The functions below evaluate the property iall = IALL_* of SBTL_TAB_N2 like
+// DIFF_ALL_VU_N2 and the flashes, so that they agree with them for the tables of a table file and
+// for float or tiled tables.
+//
+// property iall at (vt,u)
+SBTLAPI double __stdcall Z_VU_N2_T(int iall, double vt, double u) throw()
+{
+  unsigned int i, j;
+  double dx1, dx2;
+
+  IJ_VU_N2_T_INL(vt, u, i, j, dx1, dx2);
+  return SPLINE_VU_N2(CELL_VU_N2(SBTL_TAB_N2[itab_ALL_VUN2[iall]], i, j), dx1, dx2);
+}
+//
+SBTLAPI double __stdcall Z_VU_N2(int iall, double v, double u) throw()
+{
+  return Z_VU_N2_T(iall, log(v), u);
+}
+//
+// property iall with its derivatives w.r.t. v and u, and (du/dv)_z (as DIFF_P_VU_N2_T)
+SBTLAPI void __stdcall DIFF_Z_VU_N2_T(int iall,
+                                     double vt,
+                                     double v,
+                                     double u,
+                                     double & z,
+                                     double & dzdv,
+                                     double & dzdu,
+                                     double & dudv) throw()
+{
+  DIFF_VU_N2_T_INL(SBTL_TAB_N2[itab_ALL_VUN2[iall]], vt, v, u, z, dzdv, dzdu, dudv);
+}
+//
+SBTLAPI void __stdcall DIFF_Z_VU_N2(
+    int iall, double v, double u, double & z, double & dzdv, double & dzdu, double & dudv) throw()
+{
+  DIFF_Z_VU_N2_T(iall, log(v), v, u, z, dzdv, dzdu, dudv);
+}
+//
+// DIFF_Z_VU_N2_T with the derivatives w.r.t. vt instead of v (as DIFF_P_VU_N2_TT), for Newton's
+// method in (vt,u)
+SBTLAPI void __stdcall DIFF_Z_VU_N2_TT(
+    int iall, double vt, double u, double & z, double & dzdv, double & dzdu, double & dudv) throw()
+{
+  DIFF_VU_N2_T_INL(SBTL_TAB_N2[itab_ALL_VUN2[iall]], vt, 1., u, z, dzdv, dzdu, dudv);
+}
+//
+// p, t and s from a single cell search, e.g. for g = u + p v 1.e3 - t s (as G_VU_N2)
+SBTLAPI void __stdcall PTS_VU_N2_T(double vt, double u, double & p, double & t, double & s) throw()
+{
+  unsigned int i, j;
+  double dx1, dx2;
+
+  IJ_VU_N2_T_INL(vt, u, i, j, dx1, dx2);
+  p = SPLINE_VU_N2(CELL_VU_N2(SBTL_TAB_N2[ITAB_PVUN2], i, j), dx1, dx2);
+  t = SPLINE_VU_N2(CELL_VU_N2(SBTL_TAB_N2[ITAB_TVUN2], i, j), dx1, dx2);
+  s = SPLINE_VU_N2(CELL_VU_N2(SBTL_TAB_N2[ITAB_SVUN2], i, j), dx1, dx2);
+}
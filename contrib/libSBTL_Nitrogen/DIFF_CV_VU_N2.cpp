@@ -0,0 +1,49 @@
+///////////////////////////////////////////////////////////////////////////
+// LibSBTL_vu_N2 - SBTL library for gaseous nitrogen based on:
+//
+// Span, R., Lemmon, E.W., Jacobsen, R.T, Wagner, W., and Yokozeki, A.:
+//
+//   "A Reference Equation of State for the Thermodynamic Properties of Nitrogen for Temperatures
+//   from 63.151 to 1000 K and Pressures to 2200 MPa," J. Phys. Chem. Ref. Data, 29(6):1361-1433,
+//   2000.
+//
+// Lemmon, E.W. and Jacobsen, R.T.:
+//
+//   "Viscosity and Thermal Conductivity Equations for Nitrogen, Oxygen, Argon, and Air"
+//   Int. J. Thermophys., 25:21-69, 2004.
+//
+// Copyright (C) Idaho National Laboratory.
+// All rights reserved.
+//
+// Disclaimer:
+// The Idaho National Laboratory (INL) uses its best efforts to deliver a high-quality software and
+// to verify that the computed information is correct. However, INL makes no warranties to that
+// effect, and INL shall not be liable for any damage that may result from errors or omissions in
+// the software.
+//
+// Version: 0.9.0
+//
+// DIFF_CV_VU_N2 - isochoric heat capacity with derivatives
+//
+///////////////////////////////////////////////////////////////////////////
+//
+#include "math.h"
+#include "SBTL_call_conv.h"
+#include "VU_N2.h"
+//
+SBTLAPI void __stdcall DIFF_CV_VU_N2_T(double vt,
+                                       double v,
+                                       double u,
+                                       double & cv,
+                                       double & dcvdv,
+                                       double & dcvdu,
+                                       double & dudv) throw()
+{
+  DIFF_VU_N2_T_INL(SBTL_TAB_N2[ITAB_CVVUN2], vt, v, u, cv, dcvdv, dcvdu, dudv);
+}
+//
+SBTLAPI void __stdcall DIFF_CV_VU_N2(
+    double v, double u, double & cv, double & dcvdv, double & dcvdu, double & dudv) throw()
+{
+  DIFF_CV_VU_N2_T(log(v), v, u, cv, dcvdv, dcvdu, dudv);
+}
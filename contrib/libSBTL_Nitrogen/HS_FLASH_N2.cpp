@@ -30,62 +30,155 @@
 #include "math.h"
 #include "SBTL_N2.h"
 #include "SBTL_call_conv.h"
-//
-#define ITMAX 10
 
 // initial guess from auxiliary splines
 extern "C" void __stdcall VU_SH_N2_INI(double s, double h, double & vt, double & u);
 //
 // forward functions with derivatives
-extern "C" void __stdcall DIFF_P_VU_N2_T(
-    double vt, double v, double u, double & p, double & dpdv, double & dpdu, double & dudv);
-extern "C" void __stdcall DIFF_T_VU_N2_T(
-    double vt, double v, double u, double & t, double & dtdv, double & dtdu, double & dudv);
-extern "C" void __stdcall DIFF_S_VU_N2_T(
-    double vt, double v, double u, double & s, double & dsdv, double & dsdu, double & dudv);
-extern "C" void __stdcall DIFF_S_VU_N2_TT(
-    double vt, double u, double & s, double & dsdv, double & dsdu, double & dudv);
-extern "C" void __stdcall DIFF_P_VU_N2_TT(
-    double vt, double u, double & p, double & dpdv, double & dpdu, double & dudv);
+extern "C" void __stdcall DIFF_Z_VU_N2_T(int iall,
+                                         double vt,
+                                         double v,
+                                         double u,
+                                         double & z,
+                                         double & dzdv,
+                                         double & dzdu,
+                                         double & dudv);
+extern "C" void __stdcall DIFF_Z_VU_N2_TT(
+    int iall, double vt, double u, double & z, double & dzdv, double & dzdu, double & dudv);
 //
-SBTLAPI int __stdcall HS_FLASH_N2(double h, double s, double & v, double & vt, double & u) throw()
+// convergence criteria of the flashes without struct state
+static const TOL_SBTL_N2 tol_HS_N2;
+//
+// newtons method for (h,s) starting from (vt,u) with the criteria tol, adds the iterations to nit
+// and keeps the Jacobian of the last iteration in jac
+static int
+HS_NEWTON_N2(double h,
+             double s,
+             double & vt,
+             double & u,
+             const TOL_SBTL_N2 & tol,
+             int & nit,
+             JAC_SBTL_N2 & jac) throw()
 {
-  static const double df_h = 1.e-8;  //-8   //abs. deviation in h
-  static const double df_s = 1.e-10; //-8   //abs. deviation in s
-
-  double hx, sx, px, den;
+  double v, hx, sx, px = 0., den, dvt = 0., du = 0.;
   double dhdv_u, dhdu_v;
-  double dpdv_u, dpdu_v, dudv_p;
-  double dsdv_u, dsdu_v, dudv_s;
-
-  // calculate initial guesses
-  VU_SH_N2_INI(s, h, vt, u);
+  double dpdv_u = 0., dpdu_v = 0., dudv_p;
+  double dsdv_u = 0., dsdu_v = 0., dudv_s;
   v = exp(vt);
-
-  // newtons method
   double f_h = -1., f_s = -1.;
   int icount = 0;
-  while (fabs(f_h) > df_h || fabs(f_s) > df_s)
+  while (fabs(f_h) > tol.df_h || fabs(f_s) > tol.df_s)
   {
-    DIFF_P_VU_N2_TT(vt, u, px, dpdv_u, dpdu_v, dudv_p); // px, transformed derivatives
-    DIFF_S_VU_N2_TT(vt, u, sx, dsdv_u, dsdu_v, dudv_s); // sx, transformed derivatives
+    DIFF_Z_VU_N2_TT(IALL_P, vt, u, px, dpdv_u, dpdu_v, dudv_p); // px, transformed derivatives
+    DIFF_Z_VU_N2_TT(IALL_S, vt, u, sx, dsdv_u, dsdu_v, dudv_s); // sx, transformed derivatives
     hx = u + px * v * 1.e3;
     dhdv_u = (dpdv_u * v + px * v) * 1.e3;
     dhdu_v = 1. + dpdu_v * v * 1.e3;
     f_h = hx - h;
     f_s = sx - s;
     den = dhdv_u * dsdu_v - dhdu_v * dsdv_u;
-    vt = vt + (-dsdu_v * f_h + f_s * dhdu_v) / den;
-    u = u + (-f_s * dhdv_u + dsdv_u * f_h) / den;
+    dvt = (-dsdu_v * f_h + f_s * dhdu_v) / den;
+    du = (-f_s * dhdv_u + dsdv_u * f_h) / den;
+    vt = vt + dvt;
+    u = u + du;
     v = exp(vt);
-    if (icount++ > ITMAX)
+    if (icount++ > tol.itmax)
     {
+      nit += icount;
+      jac.iz = -1;
       return I_ERR;
     }
   }
+  nit += icount;
+  jac.set(IALL_S, vt, u, dvt, du, px, dpdv_u, dpdu_v, dsdv_u, dsdu_v);
+  return I_OK;
+}
+//
+SBTLAPI int __stdcall HS_FLASH_N2(double h, double s, double & v, double & vt, double & u) throw()
+{
+  // calculate initial guesses
+  VU_SH_N2_INI(s, h, vt, u);
+
+  // newtons method
+  int nit = 0;
+  JAC_SBTL_N2 jac;
+  if (HS_NEWTON_N2(h, s, vt, u, tol_HS_N2, nit, jac) != I_OK)
+    return I_ERR;
+  v = exp(vt);
+  return I_OK;
+}
+//
+SBTLAPI int __stdcall HS_FLASH_N2_WS(
+    double h, double s, double & v, double & vt, double & u, STR_vu_SBTL_N2 & st) throw()
+{
+  // previous state point (reset by GetStateHS for a new (h,s))
+  const double vt_ = st.vt;
+  const double u_ = st.u_;
+
+  // exact repeat
+  st.n_it = 0;
+  if (st.GetStateHS(h, s) == STR_PDP)
+  {
+    v = st.v_;
+    vt = st.vt;
+    u = st.u_;
+    st.n_hit++;
+    return I_OK;
+  }
+
+  // warm start from the previous state point, cold start from the auxiliary splines otherwise
+  vt = vt_;
+  u = u_;
+  if (vt_ != ERR_VAL && HS_NEWTON_N2(h, s, vt, u, st.tol, st.n_it, st.jac) == I_OK)
+    st.n_warm++;
+  else
+  {
+    VU_SH_N2_INI(s, h, vt, u);
+    if (HS_NEWTON_N2(h, s, vt, u, st.tol, st.n_it, st.jac) != I_OK)
+      return I_ERR;
+    st.n_cold++;
+  }
+  v = exp(vt);
+
+  st.v_ = v;
+  st.vt = vt;
+  st.u_ = u;
+  st.h_ = h;
+  st.s_ = s;
   return I_OK;
 }
 //
+// HS_FLASH_DERIV_N2 from p and the derivatives of p and s w.r.t. (v,u)
+static void
+HS_DERIV_PARTIALS_N2(double p,
+                     double v,
+                     double dpdv_u,
+                     double dpdu_v,
+                     double dsdv_u,
+                     double dsdu_v,
+                     double & dvdh_s,
+                     double & dvds_h,
+                     double & dhds_v,
+                     double & dudh_s,
+                     double & duds_h,
+                     double & dhds_u) throw()
+{
+  double dhdv_u, dhdu_v, dudv_h;
+  const double dudv_s = -dsdv_u / dsdu_v;
+
+  dhdv_u = (dpdv_u * v + p) * 1.e3;
+  dhdu_v = 1. + dpdu_v * v * 1.e3;
+  dudv_h = -dhdv_u / dhdu_v;
+  //
+  dvdh_s = 1. / (dhdv_u + dhdu_v * dudv_s);
+  dvds_h = 1. / (dsdv_u + dsdu_v * dudv_h);
+  dhds_v = -dvds_h / dvdh_s;
+  //
+  dudh_s = 1. / (dhdu_v + dhdv_u / dudv_s);
+  duds_h = 1. / (dsdu_v + dsdv_u / dudv_h);
+  dhds_u = -duds_h / dudh_s;
+}
+//
 SBTLAPI void __stdcall HS_FLASH_DERIV_N2(double v,
                                          double vt,
                                          double u,
@@ -96,25 +189,49 @@ SBTLAPI void __stdcall HS_FLASH_DERIV_N2(double v,
                                          double & duds_h,
                                          double & dhds_u) throw()
 {
-  double dhdv_u, dhdu_v, dudv_h;
   double dpdv_u, dpdu_v, dudv_p;
   double dsdv_u, dsdu_v, dudv_s;
   double p_, s_;
 
   // derivatives
-  DIFF_P_VU_N2_T(vt, v, u, p_, dpdv_u, dpdu_v, dudv_p);
-  DIFF_S_VU_N2_T(vt, v, u, s_, dsdv_u, dsdu_v, dudv_s);
-  dhdv_u = (dpdv_u * v + p_) * 1.e3;
-  dhdu_v = 1. + dpdu_v * v * 1.e3;
-  dudv_h = -dhdv_u / dhdu_v;
-  //
-  dvdh_s = 1. / (dhdv_u + dhdu_v * dudv_s);
-  dvds_h = 1. / (dsdv_u + dsdu_v * dudv_h);
-  dhds_v = -dvds_h / dvdh_s;
-  //
-  dudh_s = 1. / (dhdu_v + dhdv_u / dudv_s);
-  duds_h = 1. / (dsdu_v + dsdv_u / dudv_h);
-  dhds_u = -duds_h / dudh_s;
+  DIFF_Z_VU_N2_T(IALL_P, vt, v, u, p_, dpdv_u, dpdu_v, dudv_p);
+  DIFF_Z_VU_N2_T(IALL_S, vt, v, u, s_, dsdv_u, dsdu_v, dudv_s);
+  HS_DERIV_PARTIALS_N2(
+      p_, v, dpdv_u, dpdu_v, dsdv_u, dsdu_v, dvdh_s, dvds_h, dhds_v, dudh_s, duds_h, dhds_u);
+}
+//
+// HS_FLASH_DERIV_N2 after a flash with the state struct st, from the Jacobian of its last Newton
+// iteration if possible
+SBTLAPI void __stdcall HS_FLASH_DERIV_N2_WS(double v,
+                                            double vt,
+                                            double u,
+                                            double & dvdh_s,
+                                            double & dvds_h,
+                                            double & dhds_v,
+                                            double & dudh_s,
+                                            double & duds_h,
+                                            double & dhds_u,
+                                            const STR_vu_SBTL_N2 & st) throw()
+{
+  const JAC_SBTL_N2 & jac = st.jac;
+  if (jac.at(vt, u, IALL_S))
+  {
+    const double v_inv = 1. / v;
+    HS_DERIV_PARTIALS_N2(jac.p,
+                         v,
+                         jac.dpdv * v_inv,
+                         jac.dpdu,
+                         jac.dzdv * v_inv,
+                         jac.dzdu,
+                         dvdh_s,
+                         dvds_h,
+                         dhds_v,
+                         dudh_s,
+                         duds_h,
+                         dhds_u);
+  }
+  else
+    HS_FLASH_DERIV_N2(v, vt, u, dvdh_s, dvds_h, dhds_v, dudh_s, duds_h, dhds_u);
 }
 //
 SBTLAPI void __stdcall HS_PT_FLASH_DERIV_N2(double v,
@@ -136,9 +253,9 @@ SBTLAPI void __stdcall HS_PT_FLASH_DERIV_N2(double v,
   double s_;
 
   // derivatives
-  DIFF_P_VU_N2_T(vt, v, u, p, dpdv_u, dpdu_v, dudv_p);
-  DIFF_T_VU_N2_T(vt, v, u, t, dtdv_u, dtdu_v, dudv_t);
-  DIFF_S_VU_N2_T(vt, v, u, s_, dsdv_u, dsdu_v, dudv_s);
+  DIFF_Z_VU_N2_T(IALL_P, vt, v, u, p, dpdv_u, dpdu_v, dudv_p);
+  DIFF_Z_VU_N2_T(IALL_T, vt, v, u, t, dtdv_u, dtdu_v, dudv_t);
+  DIFF_Z_VU_N2_T(IALL_S, vt, v, u, s_, dsdv_u, dsdu_v, dudv_s);
   dhdv_u = (dpdv_u * v + p) * 1.e3;
   dhdu_v = 1. + dpdu_v * v * 1.e3;
   //
@@ -31,42 +31,45 @@
 #include "SBTL_N2.h"
 #include "SBTL_call_conv.h"
 //
-#define ITMAX 10
-
 // initial guess from auxiliary splines
 extern "C" double __stdcall U_VH_N2_INI_T(double vt, double h);
 //
 // forward functions with derivatives
-extern "C" void __stdcall DIFF_P_VU_N2_T(
-    double vt, double v, double u, double & p, double & dpdv, double & dpdu, double & dudv);
-extern "C" void __stdcall DIFF_P_VU_N2_TT(
-    double vt, double u, double & p, double & dpdv, double & dpdu, double & dudv);
-//
-SBTLAPI int __stdcall FLASH_VH_N2(double v, double h, double & u) throw()
+extern "C" void __stdcall DIFF_Z_VU_N2_T(int iall,
+                                         double vt,
+                                         double v,
+                                         double u,
+                                         double & z,
+                                         double & dzdv,
+                                         double & dzdu,
+                                         double & dudv);
+extern "C" void __stdcall DIFF_Z_VU_N2_TT(
+    int iall, double vt, double u, double & z, double & dzdv, double & dzdu, double & dudv);
+//
+// convergence criteria of the flashes without criteria argument
+static const TOL_SBTL_N2 tol_VH_N2;
+//
+SBTLAPI int __stdcall FLASH_VH_N2_TOL(
+    double v, double vt, double h, double & u, const TOL_SBTL_N2 & tol) throw()
 {
-  double vt;
-  static const double df_h = 1.e-8; //-8   //abs. deviation in h
-
   double hx, px;
   double dhdu_v;
   double dpdv_u, dpdu_v, dudv_p;
 
-  vt = log(v);
-
   // calculate initial guess
   u = U_VH_N2_INI_T(vt, h);
 
   // newtons method
   double f_h = -1.;
   int icount = 0;
-  while (fabs(f_h) > df_h)
+  while (fabs(f_h) > tol.df_h)
   {
-    DIFF_P_VU_N2_TT(vt, u, px, dpdv_u, dpdu_v, dudv_p); // px, transformed derivatives
+    DIFF_Z_VU_N2_TT(IALL_P, vt, u, px, dpdv_u, dpdu_v, dudv_p); // px, transformed derivatives
     hx = u + px * v * 1.e3;
     dhdu_v = 1. + dpdu_v * v * 1.e3;
     f_h = hx - h;
     u = u - f_h / dhdu_v;
-    if (icount++ > ITMAX)
+    if (icount++ > tol.itmax)
     {
       u = ERR_VAL;
       return I_ERR;
@@ -75,35 +78,14 @@ SBTLAPI int __stdcall FLASH_VH_N2(double v, double h, double & u) throw()
   return I_OK;
 }
 //
+SBTLAPI int __stdcall FLASH_VH_N2(double v, double h, double & u) throw()
+{
+  return FLASH_VH_N2_TOL(v, log(v), h, u, tol_VH_N2);
+}
+//
 SBTLAPI int __stdcall FLASH_VH_N2_T(double v, double vt, double h, double & u) throw()
 {
-
-  static const double df_h = 1.e-8; //-8   //abs. deviation in h
-
-  double hx, px;
-  double dhdu_v;
-  double dpdv_u, dpdu_v, dudv_p;
-
-  // calculate initial guess
-  u = U_VH_N2_INI_T(vt, h);
-
-  // newtons method
-  double f_h = -1.;
-  int icount = 0;
-  while (fabs(f_h) > df_h)
-  {
-    DIFF_P_VU_N2_TT(vt, u, px, dpdv_u, dpdu_v, dudv_p); // px, transformed derivatives
-    hx = u + px * v * 1.e3;
-    dhdu_v = 1. + dpdu_v * v * 1.e3;
-    f_h = hx - h;
-    u = u - f_h / dhdu_v;
-    if (icount++ > ITMAX)
-    {
-      u = ERR_VAL;
-      return I_ERR;
-    }
-  }
-  return I_OK;
+  return FLASH_VH_N2_TOL(v, vt, h, u, tol_VH_N2);
 }
 //
 SBTLAPI void __stdcall VH_FLASH_DERIV_N2(
@@ -114,7 +96,7 @@ SBTLAPI void __stdcall VH_FLASH_DERIV_N2(
   double p_;
 
   // derivatives
-  DIFF_P_VU_N2_T(vt, v, u, p_, dpdv_u, dpdu_v, dudv_p);
+  DIFF_Z_VU_N2_T(IALL_P, vt, v, u, p_, dpdv_u, dpdu_v, dudv_p);
   dhdv_u = (dpdv_u * v + p_) * 1.e3;
   dhdu_v = 1. + dpdu_v * v * 1.e3;
   dudv_h = -dhdv_u / dhdu_v;
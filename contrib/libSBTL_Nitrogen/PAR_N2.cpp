@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////
+// LibSBTL_vu_N2 - SBTL library for gaseous nitrogen based on:
+//
+// Span, R., Lemmon, E.W., Jacobsen, R.T, Wagner, W., and Yokozeki, A.:
+//
+//   "A Reference Equation of State for the Thermodynamic Properties of Nitrogen for Temperatures
+//   from 63.151 to 1000 K and Pressures to 2200 MPa," J. Phys. Chem. Ref. Data, 29(6):1361-1433,
+//   2000.
+//
+// Lemmon, E.W. and Jacobsen, R.T.:
+//
+//   "Viscosity and Thermal Conductivity Equations for Nitrogen, Oxygen, Argon, and Air"
+//   Int. J. Thermophys., 25:21-69, 2004.
+//
+// Copyright (C) Idaho National Laboratory.
+// All rights reserved.
+//
+// Disclaimer:
+// The Idaho National Laboratory (INL) uses its best efforts to deliver a high-quality software and
+// to verify that the computed information is correct. However, INL makes no warranties to that
+// effect, and INL shall not be liable for any damage that may result from errors or omissions in
+// the software.
+//
+// Version: 0.9.0
+//
+// PAR_N2 - forward functions and (p,T) flash for arrays of state points, split across threads
+//
+///////////////////////////////////////////////////////////////////////////
+//
+#include "stddef.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "SBTL_N2.h"
+#include "SBTL_call_conv.h"
+//
+SBTLAPI void __stdcall P_VU_N2_N(const double *v, const double *u, double *p, size_t n) throw();
+SBTLAPI void __stdcall T_VU_N2_N(const double *v, const double *u, double *t, size_t n) throw();
+SBTLAPI void __stdcall S_VU_N2_N(const double *v, const double *u, double *s, size_t n) throw();
+SBTLAPI void __stdcall W_VU_N2_N(const double *v, const double *u, double *w, size_t n) throw();
+SBTLAPI void __stdcall CP_VU_N2_N(const double *v, const double *u, double *cp, size_t n) throw();
+SBTLAPI void __stdcall CV_VU_N2_N(const double *v, const double *u, double *cv, size_t n) throw();
+SBTLAPI void __stdcall ETA_VU_N2_N(const double *v, const double *u, double *eta, size_t n) throw();
+SBTLAPI void __stdcall LAMBDA_VU_N2_N(const double *v, const double *u, double *lambda, size_t n) throw();
+SBTLAPI int __stdcall PT_FLASH_N2(double p, double t, double& v, double& vt, double& u) throw();
+//
+// the array functions in the order of the IALL_* indices
+typedef void (__stdcall *VU_N2_N_FN)(const double *, const double *, double *, size_t);
+static const VU_N2_N_FN fn_VU_N2_NP[NALL_VU_N2]={P_VU_N2_N, T_VU_N2_N, S_VU_N2_N, W_VU_N2_N,
+    CP_VU_N2_N, CV_VU_N2_N, ETA_VU_N2_N, LAMBDA_VU_N2_N};
+//
+// minimum number of state points per thread (fewer do not pay for starting a thread)
+#define NMIN_PAR_N2 4096
+// the chunks of the threads are multiples of this number of state points (whole cache lines and
+// whole chunks of the cell kernel of the array functions)
+#define NBLK_PAR_N2 256
+//
+// number of threads for n state points if 'nthreads' are requested (all cores if <= 0)
+static int NTHREADS_PAR_N2(size_t n, int nthreads) throw()
+{
+    if(nthreads<=0) nthreads=(int)std::thread::hardware_concurrency();
+    const size_t nmax=(n+NMIN_PAR_N2-1)/NMIN_PAR_N2;
+    if((size_t)nthreads>nmax) nthreads=(int)nmax;
+    return nthreads>0 ? nthreads : 1;
+}
+//
+// calls f(k0, k1) for 'nthreads' static chunks [k0,k1) of n state points, one per thread (the
+// first in the calling thread, which also takes a chunk if no thread can be started)
+template<typename F> static void PAR_N2(size_t n, int nthreads, F f) throw()
+{
+    const size_t nblk=(n+NBLK_PAR_N2-1)/NBLK_PAR_N2;
+    std::vector<std::thread> threads;
+    for(int it=1; it<nthreads; it++) {
+        const size_t k0=nblk*it/nthreads*NBLK_PAR_N2;
+        const size_t k1=nblk*(it+1)/nthreads*NBLK_PAR_N2;
+        try {
+            threads.emplace_back(f, k0, k1<n ? k1 : n);
+        } catch(...) {
+            f(k0, k1<n ? k1 : n);
+        }
+    }
+    const size_t k1=nblk/nthreads*NBLK_PAR_N2;
+    f(0, k1<n ? k1 : n);
+    for(size_t k=0; k<threads.size(); k++)
+        threads[k].join();
+}
+//
+// z[k] = property 'iall' (IALL_*) at (v[k], u[k]) for k < n, computed by 'nthreads' threads (all
+// cores if <= 0); the results do not depend on the number of threads (I_OK, or I_ERR for an
+// unknown property)
+SBTLAPI int __stdcall VU_N2_NP(int iall, const double *v, const double *u, double *z, size_t n, int nthreads) throw()
+{
+    if(iall<0 || iall>=NALL_VU_N2) return I_ERR;
+    const VU_N2_N_FN fn=fn_VU_N2_NP[iall];
+    PAR_N2(n, NTHREADS_PAR_N2(n, nthreads), [=](size_t k0, size_t k1) {
+        fn(v+k0, u+k0, z+k0, k1-k0);
+    });
+    return I_OK;
+}
+//
+// PT_FLASH_N2 for the state points (p[k], t[k]), k < n, computed by 'nthreads' threads (all cores
+// if <= 0); returns the number of state points for which the flash failed
+SBTLAPI size_t __stdcall PT_FLASH_N2_NP(const double *p, const double *t, double *v, double *vt, double *u, size_t n, int nthreads) throw()
+{
+    std::atomic<size_t> nerr(0);
+    PAR_N2(n, NTHREADS_PAR_N2(n, nthreads), [=, &nerr](size_t k0, size_t k1) {
+        size_t ne=0;
+        for(size_t k=k0; k<k1; k++)
+            if(PT_FLASH_N2(p[k], t[k], v[k], vt[k], u[k])!=I_OK) ne++;
+        nerr+=ne;
+    });
+    return nerr;
+}
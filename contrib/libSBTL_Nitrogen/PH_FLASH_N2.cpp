@@ -30,56 +30,230 @@
 #include "math.h"
 #include "SBTL_N2.h"
 #include "SBTL_call_conv.h"
-//
-#define ITMAX 10
 
-// initial guess from auxiliary splines
+// backward splines and initial guess from auxiliary splines
+extern "C" int __stdcall VU_PH_N2(
+    double p, double h, double & vt, double & u, double & df_p, double & df_h);
 extern "C" void __stdcall VU_HP_N2_INI(double h, double p, double & v, double & u);
 //
 // forward functions with derivatives
-extern "C" void __stdcall DIFF_P_VU_N2_T(
-    double vt, double v, double u, double & p, double & dpdv, double & dpdu, double & dudv);
-extern "C" void __stdcall DIFF_T_VU_N2_T(
-    double vt, double v, double u, double & t, double & dtdv, double & dtdu, double & dudv);
-extern "C" void __stdcall DIFF_P_VU_N2_TT(
-    double vt, double u, double & p, double & dpdv, double & dpdu, double & dudv);
+extern "C" void __stdcall DIFF_Z_VU_N2_T(int iall,
+                                         double vt,
+                                         double v,
+                                         double u,
+                                         double & z,
+                                         double & dzdv,
+                                         double & dzdu,
+                                         double & dudv);
+extern "C" void __stdcall DIFF_Z_VU_N2_TT(
+    int iall, double vt, double u, double & z, double & dzdv, double & dzdu, double & dudv);
+extern "C" void __stdcall DIFF_PT_VU_N2_T(double vt,
+                                          double v,
+                                          double u,
+                                          double & p,
+                                          double & dpdv,
+                                          double & dpdu,
+                                          double & t,
+                                          double & dtdv,
+                                          double & dtdu);
 //
-SBTLAPI int __stdcall PH_FLASH_N2(double p, double h, double & v, double & vt, double & u) throw()
+// convergence criteria of the flashes without struct state
+static const TOL_SBTL_N2 tol_PH_N2;
+//
+// starting point of newtons method: the backward splines, or the auxiliary splines if the backward
+// splines are not available
+static inline void
+VU_PH_START_N2(double p, double h, double & vt, double & u) throw()
 {
-  static const double df_p = 1.e-10; //-8   //rel. deviation in p
-  static const double df_h = 1.e-8;  //-8   //abs. deviation in h
-
-  double hx, px, den;
+  double df_p, df_h;
+  if (VU_PH_N2(p, h, vt, u, df_p, df_h) != I_OK)
+  {
+    VU_HP_N2_INI(h, p, vt, u);
+    vt = log(vt);
+  }
+}
+//
+// newtons method for (p,h) starting from (vt,u) with the criteria tol, adds the iterations to nit
+// and keeps the Jacobian of the last iteration in jac
+static int
+PH_NEWTON_N2(double p,
+             double h,
+             double & vt,
+             double & u,
+             const TOL_SBTL_N2 & tol,
+             int & nit,
+             JAC_SBTL_N2 & jac) throw()
+{
+  double v, hx, px = 0., den, dvt = 0., du = 0.;
   double dhdv_u, dhdu_v;
-  double dpdv_u, dpdu_v, dudv_p;
-
-  // calculate initial guesses
-  VU_HP_N2_INI(h, p, v, u);
-  vt = log(v);
-
-  // newtons method
+  double dpdv_u = 0., dpdu_v = 0., dudv_p;
+  v = exp(vt);
   double f_p = -1., f_h = -1., p_inv = 1. / p;
   int icount = 0;
-  while (fabs(f_p * p_inv) > df_p || fabs(f_h) > df_h)
+  while (fabs(f_p * p_inv) > tol.df_p || fabs(f_h) > tol.df_h)
   {
-    DIFF_P_VU_N2_TT(vt, u, px, dpdv_u, dpdu_v, dudv_p); // px, transformed derivatives
+    DIFF_Z_VU_N2_TT(IALL_P, vt, u, px, dpdv_u, dpdu_v, dudv_p); // px, transformed derivatives
     hx = u + px * v * 1.e3;
     dhdv_u = (dpdv_u * v + px * v) * 1.e3;
     dhdu_v = 1. + dpdu_v * v * 1.e3;
     f_p = px - p;
     f_h = hx - h;
     den = dhdu_v * dpdv_u - dhdv_u * dpdu_v;
-    vt = vt + (-dhdu_v * f_p + f_h * dpdu_v) / den;
-    u = u + (-f_h * dpdv_u + dhdv_u * f_p) / den;
+    dvt = (-dhdu_v * f_p + f_h * dpdu_v) / den;
+    du = (-f_h * dpdv_u + dhdv_u * f_p) / den;
+    vt = vt + dvt;
+    u = u + du;
     v = exp(vt);
-    if (icount++ > ITMAX)
+    if (icount++ > tol.itmax)
     {
+      nit += icount;
+      jac.iz = -1;
       return I_ERR;
     }
   }
+  nit += icount;
+  jac.set(IALL_P, vt, u, dvt, du, px, dpdv_u, dpdu_v, 0., 0.);
+  return I_OK;
+}
+//
+// warm start at (p,h) from the solution (vt,u) of the previous flash at (p_,h_): a Newton step
+// with the Jacobian of its last iteration if jac still holds it, which leaves an error of second
+// order in the distance of the state points
+static inline void
+PH_WARM_N2(double p,
+           double h,
+           double p_,
+           double h_,
+           const JAC_SBTL_N2 & jac,
+           double & vt,
+           double & u) throw()
+{
+  if (p_ == ERR_VAL || h_ == ERR_VAL || !jac.at(vt, u, IALL_P))
+    return;
+  const double v = exp(vt);
+  const double dhdv_u = (jac.dpdv * v + jac.p * v) * 1.e3;
+  const double dhdu_v = 1. + jac.dpdu * v * 1.e3;
+  const double f_p = p_ - p;
+  const double f_h = h_ - h;
+  const double den = dhdu_v * jac.dpdv - dhdv_u * jac.dpdu;
+  vt = vt + (-dhdu_v * f_p + f_h * jac.dpdu) / den;
+  u = u + (-f_h * jac.dpdv + dhdv_u * f_p) / den;
+}
+//
+SBTLAPI int __stdcall PH_FLASH_N2(double p, double h, double & v, double & vt, double & u) throw()
+{
+  // calculate initial guesses
+  VU_PH_START_N2(p, h, vt, u);
+
+  // newtons method
+  int nit = 0;
+  JAC_SBTL_N2 jac;
+  if (PH_NEWTON_N2(p, h, vt, u, tol_PH_N2, nit, jac) != I_OK)
+    return I_ERR;
+  v = exp(vt);
+  return I_OK;
+}
+//
+SBTLAPI int __stdcall PH_FLASH_N2_WS(
+    double p, double h, double & v, double & vt, double & u, STR_vu_SBTL_N2 & st) throw()
+{
+  // previous state point (reset by GetStatePH for a new (p,h))
+  const double vt_ = st.vt;
+  const double u_ = st.u_;
+  const double p_ = st.p_;
+  const double h_ = st.h_;
+
+  // exact repeat
+  st.n_it = 0;
+  if (st.GetStatePH(p, h) == STR_PDP)
+  {
+    v = st.v_;
+    vt = st.vt;
+    u = st.u_;
+    st.n_hit++;
+    return I_OK;
+  }
+
+  // the backward splines, without Newton's method if they meet the criteria by themselves and
+  // st.tol.backward is set. Otherwise Newton's method starts warm from the previous state point if
+  // its residuals, the differences in (p,h), are within the residual bounds of the backward
+  // splines (or if these are not available), from the backward splines if not or if the warm start
+  // fails, and from the auxiliary splines as the last resort
+  double df_p, df_h;
+  const bool back = VU_PH_N2(p, h, vt, u, df_p, df_h) == I_OK;
+  if (back && st.tol.backward && df_p <= st.tol.df_p && df_h <= st.tol.df_h)
+  {
+    st.jac.iz = -1;
+    st.n_cold++;
+  }
+  else
+  {
+    int ierr = I_ERR;
+    if (vt_ != ERR_VAL && (!back || (fabs(p - p_) <= df_p * p && fabs(h - h_) <= df_h)))
+    {
+      vt = vt_;
+      u = u_;
+      PH_WARM_N2(p, h, p_, h_, st.jac, vt, u);
+      ierr = PH_NEWTON_N2(p, h, vt, u, st.tol, st.n_it, st.jac);
+      if (ierr == I_OK)
+        st.n_warm++;
+      else if (back)
+        VU_PH_N2(p, h, vt, u, df_p, df_h);
+    }
+    if (ierr != I_OK && back)
+    {
+      ierr = PH_NEWTON_N2(p, h, vt, u, st.tol, st.n_it, st.jac);
+      if (ierr == I_OK)
+        st.n_cold++;
+    }
+    if (ierr != I_OK)
+    {
+      VU_HP_N2_INI(h, p, v, u);
+      vt = log(v);
+      if (PH_NEWTON_N2(p, h, vt, u, st.tol, st.n_it, st.jac) != I_OK)
+        return I_ERR;
+      st.n_cold++;
+    }
+  }
+  v = exp(vt);
+
+  st.v_ = v;
+  st.vt = vt;
+  st.u_ = u;
+  st.p_ = p;
+  st.h_ = h;
   return I_OK;
 }
 //
+// PH_FLASH_DERIV_N2 from the derivatives of p w.r.t. (v,u)
+static void
+PH_DERIV_PARTIALS_N2(double p,
+                     double v,
+                     double dpdv_u,
+                     double dpdu_v,
+                     double & dvdp_h,
+                     double & dvdh_p,
+                     double & dpdh_v,
+                     double & dudp_h,
+                     double & dudh_p,
+                     double & dpdh_u) throw()
+{
+  double dhdv_u, dhdu_v, dudv_h;
+  const double dudv_p = -dpdv_u / dpdu_v;
+
+  dhdv_u = (dpdv_u * v + p) * 1.e3;
+  dhdu_v = 1. + dpdu_v * v * 1.e3;
+  dudv_h = -dhdv_u / dhdu_v;
+  //
+  dvdp_h = 1. / (dpdv_u + dpdu_v * dudv_h);
+  dvdh_p = 1. / (dhdv_u + dhdu_v * dudv_p);
+  dpdh_v = -dvdh_p / dvdp_h;
+  //
+  dudp_h = 1. / (dpdu_v + dpdv_u / dudv_h);
+  dudh_p = 1. / (dhdu_v + dhdv_u / dudv_p);
+  dpdh_u = -dudh_p / dudp_h;
+}
+//
 SBTLAPI void __stdcall PH_FLASH_DERIV_N2(double p,
                                          double v,
                                          double vt,
@@ -91,23 +265,56 @@ SBTLAPI void __stdcall PH_FLASH_DERIV_N2(double p,
                                          double & dudh_p,
                                          double & dpdh_u) throw()
 {
-  double dhdv_u, dhdu_v, dudv_h;
   double dpdv_u, dpdu_v, dudv_p;
   double p_;
 
   // derivatives
-  DIFF_P_VU_N2_T(vt, v, u, p_, dpdv_u, dpdu_v, dudv_p);
+  DIFF_Z_VU_N2_T(IALL_P, vt, v, u, p_, dpdv_u, dpdu_v, dudv_p);
+  PH_DERIV_PARTIALS_N2(p, v, dpdv_u, dpdu_v, dvdp_h, dvdh_p, dpdh_v, dudp_h, dudh_p, dpdh_u);
+}
+//
+// PH_FLASH_DERIV_N2 after a flash with the state struct st, from the Jacobian of its last Newton
+// iteration if possible
+SBTLAPI void __stdcall PH_FLASH_DERIV_N2_WS(double p,
+                                            double v,
+                                            double vt,
+                                            double u,
+                                            double & dvdp_h,
+                                            double & dvdh_p,
+                                            double & dpdh_v,
+                                            double & dudp_h,
+                                            double & dudh_p,
+                                            double & dpdh_u,
+                                            const STR_vu_SBTL_N2 & st) throw()
+{
+  const JAC_SBTL_N2 & jac = st.jac;
+  if (jac.at(vt, u, IALL_P))
+    PH_DERIV_PARTIALS_N2(
+        jac.p, v, jac.dpdv / v, jac.dpdu, dvdp_h, dvdh_p, dpdh_v, dudp_h, dudh_p, dpdh_u);
+  else
+    PH_FLASH_DERIV_N2(p, v, vt, u, dvdp_h, dvdh_p, dpdh_v, dudp_h, dudh_p, dpdh_u);
+}
+//
+// PH_T_FLASH_DERIV_G_N2 from the derivatives of p and t w.r.t. (v,u)
+static void
+PH_T_DERIV_PARTIALS_N2(double p,
+                       double v,
+                       double dpdv_u,
+                       double dpdu_v,
+                       double dtdv_u,
+                       double dtdu_v,
+                       double & dtdp_h,
+                       double & dtdh_p,
+                       double & dpdh_t) throw()
+{
+  double dhdv_u, dhdu_v;
+
   dhdv_u = (dpdv_u * v + p) * 1.e3;
   dhdu_v = 1. + dpdu_v * v * 1.e3;
-  dudv_h = -dhdv_u / dhdu_v;
-  //
-  dvdp_h = 1. / (dpdv_u + dpdu_v * dudv_h);
-  dvdh_p = 1. / (dhdv_u + dhdu_v * dudv_p);
-  dpdh_v = -dvdh_p / dvdp_h;
   //
-  dudp_h = 1. / (dpdu_v + dpdv_u / dudv_h);
-  dudh_p = 1. / (dhdu_v + dhdv_u / dudv_p);
-  dpdh_u = -dudh_p / dudp_h;
+  dtdp_h = (dtdv_u * dhdu_v - dtdu_v * dhdv_u) / (dpdv_u * dhdu_v - dpdu_v * dhdv_u);
+  dtdh_p = (dtdv_u * dpdu_v - dtdu_v * dpdv_u) / (dhdv_u * dpdu_v - dhdu_v * dpdv_u);
+  dpdh_t = -dtdh_p / dtdp_h;
 }
 //
 SBTLAPI void __stdcall PH_T_FLASH_DERIV_G_N2(double p,
@@ -119,18 +326,35 @@ SBTLAPI void __stdcall PH_T_FLASH_DERIV_G_N2(double p,
                                              double & dtdh_p,
                                              double & dpdh_t) throw()
 {
-  double dhdv_u, dhdu_v;
-  double dpdv_u, dpdu_v, dudv_p;
-  double dtdv_u, dtdu_v, dudv_t;
+  double dpdv_u, dpdu_v;
+  double dtdv_u, dtdu_v;
   double p_;
 
   // derivatives
-  DIFF_P_VU_N2_T(vt, v, u, p_, dpdv_u, dpdu_v, dudv_p);
-  DIFF_T_VU_N2_T(vt, v, u, t, dtdv_u, dtdu_v, dudv_t);
-  dhdv_u = (dpdv_u * v + p) * 1.e3;
-  dhdu_v = 1. + dpdu_v * v * 1.e3;
-  //
-  dtdp_h = (dtdv_u * dhdu_v - dtdu_v * dhdv_u) / (dpdv_u * dhdu_v - dpdu_v * dhdv_u);
-  dtdh_p = (dtdv_u * dpdu_v - dtdu_v * dpdv_u) / (dhdv_u * dpdu_v - dhdu_v * dpdv_u);
-  dpdh_t = -dtdh_p / dtdp_h;
+  DIFF_PT_VU_N2_T(vt, v, u, p_, dpdv_u, dpdu_v, t, dtdv_u, dtdu_v);
+  PH_T_DERIV_PARTIALS_N2(p, v, dpdv_u, dpdu_v, dtdv_u, dtdu_v, dtdp_h, dtdh_p, dpdh_t);
+}
+//
+// PH_T_FLASH_DERIV_G_N2 after a flash with the state struct st: the derivatives of p from the
+// Jacobian of its last Newton iteration if possible, so that only t is evaluated
+SBTLAPI void __stdcall PH_T_FLASH_DERIV_G_N2_WS(double p,
+                                                double v,
+                                                double vt,
+                                                double u,
+                                                double & t,
+                                                double & dtdp_h,
+                                                double & dtdh_p,
+                                                double & dpdh_t,
+                                                const STR_vu_SBTL_N2 & st) throw()
+{
+  const JAC_SBTL_N2 & jac = st.jac;
+  if (jac.at(vt, u, IALL_P))
+  {
+    double dtdv_u, dtdu_v, dudv_t;
+    DIFF_Z_VU_N2_T(IALL_T, vt, v, u, t, dtdv_u, dtdu_v, dudv_t);
+    PH_T_DERIV_PARTIALS_N2(
+        jac.p, v, jac.dpdv / v, jac.dpdu, dtdv_u, dtdu_v, dtdp_h, dtdh_p, dpdh_t);
+  }
+  else
+    PH_T_FLASH_DERIV_G_N2(p, v, vt, u, t, dtdp_h, dtdh_p, dpdh_t);
 }
@@ -31,54 +31,211 @@
 #include "SBTL_N2.h"
 #include "SBTL_call_conv.h"
 //
-#define ITMAX 10
-//
-// initial guess from auxiliary splines
+// backward splines and initial guess from auxiliary splines
+extern "C" int __stdcall VU_PS_N2(
+    double p, double s, double & vt, double & u, double & df_p, double & df_s);
 extern "C" void __stdcall VU_SP_N2_INI(double s, double p, double & vt, double & u);
 //
 // forward functions with derivatives
-extern "C" void __stdcall DIFF_P_VU_N2_T(
-    double vt, double v, double u, double & p, double & dpdv, double & dpdu, double & dudv);
-extern "C" void __stdcall DIFF_S_VU_N2_T(
-    double vt, double v, double u, double & s, double & dsdv, double & dsdu, double & dudv);
-extern "C" void __stdcall DIFF_P_VU_N2_TT(
-    double vt, double u, double & p, double & dpdv, double & dpdu, double & dudv);
-extern "C" void __stdcall DIFF_S_VU_N2_TT(
-    double vt, double u, double & s, double & dsdv, double & dsdu, double & dudv);
+extern "C" void __stdcall DIFF_Z_VU_N2_T(int iall,
+                                         double vt,
+                                         double v,
+                                         double u,
+                                         double & z,
+                                         double & dzdv,
+                                         double & dzdu,
+                                         double & dudv);
+extern "C" void __stdcall DIFF_PS_VU_N2_TT(double vt,
+                                           double u,
+                                           double & p,
+                                           double & dpdv,
+                                           double & dpdu,
+                                           double & s,
+                                           double & dsdv,
+                                           double & dsdu);
 //
-SBTLAPI int __stdcall PS_FLASH_N2(double p, double s, double & v, double & vt, double & u) throw()
+// convergence criteria of the flashes without struct state
+static const TOL_SBTL_N2 tol_PS_N2;
+//
+// starting point of newtons method: the backward splines, or the auxiliary splines if the backward
+// splines are not available
+static inline void
+VU_PS_START_N2(double p, double s, double & vt, double & u) throw()
 {
-  static const double df_p = 1.e-10; //-8   //rel. deviation in p
-  static const double df_s = 1.e-10; //-8   //abs. deviation in t
-
-  double sx, px, den;
-  double dsdv_u, dsdu_v, dudv_s;
-  double dpdv_u, dpdu_v, dudv_p;
-
-  // calculate initial guesses
-  VU_SP_N2_INI(s, p, vt, u);
-
-  // newtons method
+  double df_p, df_s;
+  if (VU_PS_N2(p, s, vt, u, df_p, df_s) != I_OK)
+    VU_SP_N2_INI(s, p, vt, u);
+}
+//
+// newtons method for (p,s) starting from (vt,u) with the criteria tol, adds the iterations to nit
+// and keeps the Jacobian of the last iteration in jac
+static int
+PS_NEWTON_N2(double p,
+             double s,
+             double & vt,
+             double & u,
+             const TOL_SBTL_N2 & tol,
+             int & nit,
+             JAC_SBTL_N2 & jac) throw()
+{
+  double sx, px = 0., den, dvt = 0., du = 0.;
+  double dsdv_u = 0., dsdu_v = 0.;
+  double dpdv_u = 0., dpdu_v = 0.;
   double f_p = -1., f_s = -1., p_inv = 1. / p;
   int icount = 0;
-  while (fabs(f_p * p_inv) > df_p || fabs(f_s) > df_s)
+  while (fabs(f_p * p_inv) > tol.df_p || fabs(f_s) > tol.df_s)
   {
-    DIFF_P_VU_N2_TT(vt, u, px, dpdv_u, dpdu_v, dudv_p); // px, transformed derivatives
-    DIFF_S_VU_N2_TT(vt, u, sx, dsdv_u, dsdu_v, dudv_s); // sx, transformed derivatives
+    // px, sx, transformed derivatives from a single cell search
+    DIFF_PS_VU_N2_TT(vt, u, px, dpdv_u, dpdu_v, sx, dsdv_u, dsdu_v);
     f_p = px - p;
     f_s = sx - s;
     den = dsdu_v * dpdv_u - dsdv_u * dpdu_v;
-    vt = vt + (-dsdu_v * f_p + f_s * dpdu_v) / den;
-    u = u + (-f_s * dpdv_u + dsdv_u * f_p) / den;
-    if (icount++ > ITMAX)
+    dvt = (-dsdu_v * f_p + f_s * dpdu_v) / den;
+    du = (-f_s * dpdv_u + dsdv_u * f_p) / den;
+    vt = vt + dvt;
+    u = u + du;
+    if (icount++ > tol.itmax)
     {
+      nit += icount;
+      jac.iz = -1;
       return I_ERR;
     }
   }
+  nit += icount;
+  jac.set(IALL_S, vt, u, dvt, du, px, dpdv_u, dpdu_v, dsdv_u, dsdu_v);
+  return I_OK;
+}
+//
+// warm start at (p,s) from the solution (vt,u) of the previous flash at (p_,s_): a Newton step
+// with the Jacobian of its last iteration if jac still holds it, which leaves an error of second
+// order in the distance of the state points
+static inline void
+PS_WARM_N2(double p,
+           double s,
+           double p_,
+           double s_,
+           const JAC_SBTL_N2 & jac,
+           double & vt,
+           double & u) throw()
+{
+  if (p_ == ERR_VAL || s_ == ERR_VAL || !jac.at(vt, u, IALL_S))
+    return;
+  const double f_p = p_ - p;
+  const double f_s = s_ - s;
+  const double den = jac.dzdu * jac.dpdv - jac.dzdv * jac.dpdu;
+  vt = vt + (-jac.dzdu * f_p + f_s * jac.dpdu) / den;
+  u = u + (-f_s * jac.dpdv + jac.dzdv * f_p) / den;
+}
+//
+SBTLAPI int __stdcall PS_FLASH_N2(double p, double s, double & v, double & vt, double & u) throw()
+{
+  // calculate initial guesses
+  VU_PS_START_N2(p, s, vt, u);
+
+  // newtons method
+  int nit = 0;
+  JAC_SBTL_N2 jac;
+  if (PS_NEWTON_N2(p, s, vt, u, tol_PS_N2, nit, jac) != I_OK)
+    return I_ERR;
   v = exp(vt);
   return I_OK;
 }
 //
+SBTLAPI int __stdcall PS_FLASH_N2_WS(
+    double p, double s, double & v, double & vt, double & u, STR_vu_SBTL_N2 & st) throw()
+{
+  // previous state point (reset by GetStatePS for a new (p,s))
+  const double vt_ = st.vt;
+  const double u_ = st.u_;
+  const double p_ = st.p_;
+  const double s_ = st.s_;
+
+  // exact repeat
+  st.n_it = 0;
+  if (st.GetStatePS(p, s) == STR_PDP)
+  {
+    v = st.v_;
+    vt = st.vt;
+    u = st.u_;
+    st.n_hit++;
+    return I_OK;
+  }
+
+  // the backward splines, without Newton's method if they meet the criteria by themselves and
+  // st.tol.backward is set. Otherwise Newton's method starts warm from the previous state point if
+  // its residuals, the differences in (p,s), are within the residual bounds of the backward
+  // splines (or if these are not available), from the backward splines if not or if the warm start
+  // fails, and from the auxiliary splines as the last resort
+  double df_p, df_s;
+  const bool back = VU_PS_N2(p, s, vt, u, df_p, df_s) == I_OK;
+  if (back && st.tol.backward && df_p <= st.tol.df_p && df_s <= st.tol.df_s)
+  {
+    st.jac.iz = -1;
+    st.n_cold++;
+  }
+  else
+  {
+    int ierr = I_ERR;
+    if (vt_ != ERR_VAL && (!back || (fabs(p - p_) <= df_p * p && fabs(s - s_) <= df_s)))
+    {
+      vt = vt_;
+      u = u_;
+      PS_WARM_N2(p, s, p_, s_, st.jac, vt, u);
+      ierr = PS_NEWTON_N2(p, s, vt, u, st.tol, st.n_it, st.jac);
+      if (ierr == I_OK)
+        st.n_warm++;
+      else if (back)
+        VU_PS_N2(p, s, vt, u, df_p, df_s);
+    }
+    if (ierr != I_OK && back)
+    {
+      ierr = PS_NEWTON_N2(p, s, vt, u, st.tol, st.n_it, st.jac);
+      if (ierr == I_OK)
+        st.n_cold++;
+    }
+    if (ierr != I_OK)
+    {
+      VU_SP_N2_INI(s, p, vt, u);
+      if (PS_NEWTON_N2(p, s, vt, u, st.tol, st.n_it, st.jac) != I_OK)
+        return I_ERR;
+      st.n_cold++;
+    }
+  }
+  v = exp(vt);
+
+  st.v_ = v;
+  st.vt = vt;
+  st.u_ = u;
+  st.p_ = p;
+  st.s_ = s;
+  return I_OK;
+}
+//
+// PS_FLASH_DERIV_N2 from the derivatives of p and s w.r.t. (v,u)
+static void
+PS_DERIV_PARTIALS_N2(double dpdv_u,
+                     double dpdu_v,
+                     double dsdv_u,
+                     double dsdu_v,
+                     double & dvdp_s,
+                     double & dvds_p,
+                     double & dpds_v,
+                     double & dudp_s,
+                     double & duds_p,
+                     double & dpds_u) throw()
+{
+  const double dudv_s = -dsdv_u / dsdu_v;
+  const double dudv_p = -dpdv_u / dpdu_v;
+  //
+  dvdp_s = 1. / (dpdv_u + dpdu_v * dudv_s);
+  dvds_p = 1. / (dsdv_u + dsdu_v * dudv_p);
+  dpds_v = -dvds_p / dvdp_s;
+  //
+  dudp_s = 1. / (dpdu_v + dpdv_u / dudv_s);
+  duds_p = 1. / (dsdu_v + dsdv_u / dudv_p);
+  dpds_u = -duds_p / dudp_s;
+}
+//
 SBTLAPI void __stdcall PS_FLASH_DERIV_N2(double v,
                                          double vt,
                                          double u,
@@ -94,47 +251,52 @@ SBTLAPI void __stdcall PS_FLASH_DERIV_N2(double v,
   double p_, s_;
 
   // derivatives
-  DIFF_P_VU_N2_T(vt, v, u, p_, dpdv_u, dpdu_v, dudv_p);
-  DIFF_S_VU_N2_T(vt, v, u, s_, dsdv_u, dsdu_v, dudv_s);
-  //
-  dvdp_s = 1. / (dpdv_u + dpdu_v * dudv_s);
-  dvds_p = 1. / (dsdv_u + dsdu_v * dudv_p);
-  dpds_v = -dvds_p / dvdp_s;
-  //
-  dudp_s = 1. / (dpdu_v + dpdv_u / dudv_s);
-  duds_p = 1. / (dsdu_v + dsdv_u / dudv_p);
-  dpds_u = -duds_p / dudp_s;
+  DIFF_Z_VU_N2_T(IALL_P, vt, v, u, p_, dpdv_u, dpdu_v, dudv_p);
+  DIFF_Z_VU_N2_T(IALL_S, vt, v, u, s_, dsdv_u, dsdu_v, dudv_s);
+  PS_DERIV_PARTIALS_N2(
+      dpdv_u, dpdu_v, dsdv_u, dsdu_v, dvdp_s, dvds_p, dpds_v, dudp_s, duds_p, dpds_u);
+}
+//
+// PS_FLASH_DERIV_N2 after a flash with the state struct st, from the Jacobian of its last Newton
+// iteration if possible
+SBTLAPI void __stdcall PS_FLASH_DERIV_N2_WS(double v,
+                                            double vt,
+                                            double u,
+                                            double & dvdp_s,
+                                            double & dvds_p,
+                                            double & dpds_v,
+                                            double & dudp_s,
+                                            double & duds_p,
+                                            double & dpds_u,
+                                            const STR_vu_SBTL_N2 & st) throw()
+{
+  const JAC_SBTL_N2 & jac = st.jac;
+  if (jac.at(vt, u, IALL_S))
+  {
+    const double v_inv = 1. / v;
+    PS_DERIV_PARTIALS_N2(jac.dpdv * v_inv,
+                         jac.dpdu,
+                         jac.dzdv * v_inv,
+                         jac.dzdu,
+                         dvdp_s,
+                         dvds_p,
+                         dpds_v,
+                         dudp_s,
+                         duds_p,
+                         dpds_u);
+  }
+  else
+    PS_FLASH_DERIV_N2(v, vt, u, dvdp_s, dvds_p, dpds_v, dudp_s, duds_p, dpds_u);
 }
 //
 SBTLAPI int
 PS_FLASH_N2_T(double p, double s, double & vt, double & u) throw()
 {
-  static const double df_p = 1.e-10; //-8   //rel. deviation in p
-  static const double df_s = 1.e-10; //-8   //abs. deviation in s
-
-  double sx, px, den;
-  double dsdv_u, dsdu_v, dudv_s;
-  double dpdv_u, dpdu_v, dudv_p;
-
   // calculate initial guesses
-  VU_SP_N2_INI(s, p, vt, u);
+  VU_PS_START_N2(p, s, vt, u);
 
   // newtons method
-  double f_p = -1., f_s = -1., p_inv = 1. / p;
-  int icount = 0;
-  while (fabs(f_p * p_inv) > df_p || fabs(f_s) > df_s)
-  {
-    DIFF_P_VU_N2_TT(vt, u, px, dpdv_u, dpdu_v, dudv_p); // px, transformed derivatives
-    DIFF_S_VU_N2_TT(vt, u, sx, dsdv_u, dsdu_v, dudv_s); // sx, transformed derivatives
-    f_p = px - p;
-    f_s = sx - s;
-    den = dsdu_v * dpdv_u - dsdv_u * dpdu_v;
-    vt = vt + (-dsdu_v * f_p + f_s * dpdu_v) / den;
-    u = u + (-f_s * dpdv_u + dsdv_u * f_p) / den;
-    if (icount++ > ITMAX)
-    {
-      return I_ERR;
-    }
-  }
-  return I_OK;
+  int nit = 0;
+  JAC_SBTL_N2 jac;
+  return PS_NEWTON_N2(p, s, vt, u, tol_PS_N2, nit, jac);
 }
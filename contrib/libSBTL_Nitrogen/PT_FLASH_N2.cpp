@@ -31,54 +31,279 @@
 #include "SBTL_N2.h"
 #include "SBTL_call_conv.h"
 //
-#define ITMAX 10
-//
-// initial guess from auxiliary splines
+// backward splines and initial guess from auxiliary splines
+extern "C" int __stdcall VU_PT_N2(
+    double p, double t, double & vt, double & u, double & df_p, double & df_t);
 extern "C" void __stdcall VU_TP_N2_INI(double t, double p, double & vt, double & u);
 //
 // forward functions with derivatives
-extern "C" void __stdcall DIFF_P_VU_N2_T(
-    double vt, double v, double u, double & p, double & dpdv, double & dpdu, double & dudv);
-extern "C" void __stdcall DIFF_T_VU_N2_T(
-    double vt, double v, double u, double & t, double & dtdv, double & dtdu, double & dudv);
-extern "C" void __stdcall DIFF_P_VU_N2_TT(
-    double vt, double u, double & p, double & dpdv, double & dpdu, double & dudv);
-extern "C" void __stdcall DIFF_T_VU_N2_TT(
-    double vt, double u, double & t, double & dtdv, double & dtdu, double & dudv);
+extern "C" void __stdcall DIFF_PT_VU_N2_T(double vt,
+                                          double v,
+                                          double u,
+                                          double & p,
+                                          double & dpdv,
+                                          double & dpdu,
+                                          double & t,
+                                          double & dtdv,
+                                          double & dtdu);
+extern "C" void __stdcall DIFF_PT_VU_N2_TT(double vt,
+                                           double u,
+                                           double & p,
+                                           double & dpdv,
+                                           double & dpdu,
+                                           double & t,
+                                           double & dtdv,
+                                           double & dtdu);
 //
-SBTLAPI int __stdcall PT_FLASH_N2(double p, double t, double & v, double & vt, double & u) throw()
+// convergence criteria of the flashes without struct state
+static const TOL_SBTL_N2 tol_PT_N2;
+//
+// starting point of newtons method: the backward splines, which are close enough for one
+// polishing step, or the auxiliary splines if the backward splines are not available
+static inline void
+VU_PT_START_N2(double p, double t, double & vt, double & u) throw()
 {
-  static const double df_p = 1.e-10; // rel. deviation in p
-  static const double df_t = 1.e-10; // abs. deviation in t
-
-  double tx, px, den;
-  double dtdv_u, dtdu_v, dudv_t;
-  double dpdv_u, dpdu_v, dudv_p;
-
-  // calculate initial guesses
-  VU_TP_N2_INI(t, p, vt, u);
+  double df_p, df_t;
+  if (VU_PT_N2(p, t, vt, u, df_p, df_t) != I_OK)
+    VU_TP_N2_INI(t, p, vt, u);
+}
+//
+// newtons method for (p,t) starting from (vt,u) with the criteria tol, adds the iterations to nit
+// and keeps the Jacobian of the last iteration in jac
+static int
+PT_NEWTON_N2(double p,
+             double t,
+             double & vt,
+             double & u,
+             const TOL_SBTL_N2 & tol,
+             int & nit,
+             JAC_SBTL_N2 & jac) throw()
+{
+  double tx, px = 0., den, dvt = 0., du = 0.;
+  double dtdv_u = 0., dtdu_v = 0.;
+  double dpdv_u = 0., dpdu_v = 0.;
 
-  // newtons method
   double f_p = -1., f_t = -1., p_inv = 1. / p;
   int icount = 0;
-  while (fabs(f_p * p_inv) > df_p || fabs(f_t) > df_t)
+  while (fabs(f_p * p_inv) > tol.df_p || fabs(f_t) > tol.df_t)
   {
-    DIFF_P_VU_N2_TT(vt, u, px, dpdv_u, dpdu_v, dudv_p); // px, transformed derivatives
-    DIFF_T_VU_N2_TT(vt, u, tx, dtdv_u, dtdu_v, dudv_t); // tx, transformed derivatives
+    // px, tx, transformed derivatives from a single cell search
+    DIFF_PT_VU_N2_TT(vt, u, px, dpdv_u, dpdu_v, tx, dtdv_u, dtdu_v);
     f_p = px - p;
     f_t = tx - t;
     den = dtdu_v * dpdv_u - dtdv_u * dpdu_v;
-    vt = vt + (-dtdu_v * f_p + f_t * dpdu_v) / den;
-    u = u + (-f_t * dpdv_u + dtdv_u * f_p) / den;
-    if (icount++ > ITMAX)
+    dvt = (-dtdu_v * f_p + f_t * dpdu_v) / den;
+    du = (-f_t * dpdv_u + dtdv_u * f_p) / den;
+    vt = vt + dvt;
+    u = u + du;
+    if (icount++ > tol.itmax)
     {
+      nit += icount;
+      jac.iz = -1;
       return I_ERR;
     }
   }
+  nit += icount;
+  jac.set(IALL_T, vt, u, dvt, du, px, dpdv_u, dpdu_v, dtdv_u, dtdu_v);
+  return I_OK;
+}
+//
+// PT_DERIV_N2 from the derivatives of p and t w.r.t. (v,u)
+static void
+PT_DERIV_PARTIALS_N2(double dpdv_u,
+                     double dpdu_v,
+                     double dtdv_u,
+                     double dtdu_v,
+                     double & dvdp_t,
+                     double & dvdt_p,
+                     double & dpdt_v,
+                     double & dudp_t,
+                     double & dudt_p,
+                     double & dpdt_u) throw()
+{
+  const double dudv_t = -dtdv_u / dtdu_v;
+  const double dudv_p = -dpdv_u / dpdu_v;
+  //
+  dvdp_t = 1. / (dpdv_u + dpdu_v * dudv_t);
+  dvdt_p = 1. / (dtdv_u + dtdu_v * dudv_p);
+  dpdt_v = -dvdt_p / dvdp_t;
+  //
+  dudp_t = 1. / (dpdu_v + dpdv_u / dudv_t);
+  dudt_p = 1. / (dtdu_v + dtdv_u / dudv_p);
+  dpdt_u = -dudt_p / dudp_t;
+}
+//
+// warm start at (p,t) from the solution (vt,u) of the previous flash at (p_,t_): a Newton step
+// with the Jacobian of its last iteration if jac still holds it, which leaves an error of second
+// order in the distance of the state points
+static inline void
+PT_WARM_N2(double p,
+           double t,
+           double p_,
+           double t_,
+           const JAC_SBTL_N2 & jac,
+           double & vt,
+           double & u) throw()
+{
+  if (p_ == ERR_VAL || t_ == ERR_VAL || !jac.at(vt, u, IALL_T))
+    return;
+  const double f_p = p_ - p;
+  const double f_t = t_ - t;
+  const double den = jac.dzdu * jac.dpdv - jac.dzdv * jac.dpdu;
+  vt = vt + (-jac.dzdu * f_p + f_t * jac.dpdu) / den;
+  u = u + (-f_t * jac.dpdv + jac.dzdv * f_p) / den;
+}
+//
+SBTLAPI int __stdcall PT_FLASH_N2(double p, double t, double & v, double & vt, double & u) throw()
+{
+  // calculate initial guesses
+  VU_PT_START_N2(p, t, vt, u);
+
+  // newtons method
+  int nit = 0;
+  JAC_SBTL_N2 jac;
+  if (PT_NEWTON_N2(p, t, vt, u, tol_PT_N2, nit, jac) != I_OK)
+    return I_ERR;
+  v = exp(vt);
+  return I_OK;
+}
+//
+SBTLAPI int __stdcall PT_FLASH_N2_WS(
+    double p, double t, double & v, double & vt, double & u, STR_vu_SBTL_N2 & st) throw()
+{
+  // previous state point (reset by GetStatePT for a new (p,t))
+  const double vt_ = st.vt;
+  const double u_ = st.u_;
+  const double p_ = st.p_;
+  const double t_ = st.t_;
+
+  // exact repeat
+  st.n_it = 0;
+  if (st.GetStatePT(p, t) == STR_PDP)
+  {
+    v = st.v_;
+    vt = st.vt;
+    u = st.u_;
+    st.n_hit++;
+    return I_OK;
+  }
+
+  // the backward splines, without Newton's method if they meet the criteria by themselves and
+  // st.tol.backward is set. Otherwise Newton's method starts warm from the previous state point if
+  // its residuals, the differences in (p,t), are within the residual bounds of the backward
+  // splines (or if these are not available), from the backward splines if not or if the warm start
+  // fails, and from the auxiliary splines as the last resort
+  double df_p, df_t;
+  const bool back = VU_PT_N2(p, t, vt, u, df_p, df_t) == I_OK;
+  if (back && st.tol.backward && df_p <= st.tol.df_p && df_t <= st.tol.df_t)
+  {
+    st.jac.iz = -1;
+    st.n_cold++;
+  }
+  else
+  {
+    int ierr = I_ERR;
+    if (vt_ != ERR_VAL && (!back || (fabs(p - p_) <= df_p * p && fabs(t - t_) <= df_t)))
+    {
+      vt = vt_;
+      u = u_;
+      PT_WARM_N2(p, t, p_, t_, st.jac, vt, u);
+      ierr = PT_NEWTON_N2(p, t, vt, u, st.tol, st.n_it, st.jac);
+      if (ierr == I_OK)
+        st.n_warm++;
+      else if (back)
+        VU_PT_N2(p, t, vt, u, df_p, df_t);
+    }
+    if (ierr != I_OK && back)
+    {
+      ierr = PT_NEWTON_N2(p, t, vt, u, st.tol, st.n_it, st.jac);
+      if (ierr == I_OK)
+        st.n_cold++;
+    }
+    if (ierr != I_OK)
+    {
+      VU_TP_N2_INI(t, p, vt, u);
+      if (PT_NEWTON_N2(p, t, vt, u, st.tol, st.n_it, st.jac) != I_OK)
+        return I_ERR;
+      st.n_cold++;
+    }
+  }
   v = exp(vt);
+
+  st.v_ = v;
+  st.vt = vt;
+  st.u_ = u;
+  st.p_ = p;
+  st.t_ = t;
   return I_OK;
 }
 //
+SBTLAPI void __stdcall PT_DERIV_N2(double v,
+                                   double vt,
+                                   double u,
+                                   double & dvdp_t,
+                                   double & dvdt_p,
+                                   double & dpdt_v,
+                                   double & dudp_t,
+                                   double & dudt_p,
+                                   double & dpdt_u) throw()
+{
+  double dtdv_u, dtdu_v;
+  double dpdv_u, dpdu_v;
+  double p_, t_;
+
+  // derivatives
+  DIFF_PT_VU_N2_T(vt, v, u, p_, dpdv_u, dpdu_v, t_, dtdv_u, dtdu_v);
+  PT_DERIV_PARTIALS_N2(
+      dpdv_u, dpdu_v, dtdv_u, dtdu_v, dvdp_t, dvdt_p, dpdt_v, dudp_t, dudt_p, dpdt_u);
+}
+//
+// PT_DERIV_N2 from the Jacobian jac of the last Newton iteration if possible
+static void
+PT_DERIV_JAC_N2(double v,
+                double vt,
+                double u,
+                const JAC_SBTL_N2 & jac,
+                double & dvdp_t,
+                double & dvdt_p,
+                double & dpdt_v,
+                double & dudp_t,
+                double & dudt_p,
+                double & dpdt_u) throw()
+{
+  if (jac.at(vt, u, IALL_T))
+  {
+    const double v_inv = 1. / v;
+    PT_DERIV_PARTIALS_N2(jac.dpdv * v_inv,
+                         jac.dpdu,
+                         jac.dzdv * v_inv,
+                         jac.dzdu,
+                         dvdp_t,
+                         dvdt_p,
+                         dpdt_v,
+                         dudp_t,
+                         dudt_p,
+                         dpdt_u);
+  }
+  else
+    PT_DERIV_N2(v, vt, u, dvdp_t, dvdt_p, dpdt_v, dudp_t, dudt_p, dpdt_u);
+}
+//
+// PT_DERIV_N2 after PT_FLASH_N2_WS with the state struct st
+SBTLAPI void __stdcall PT_DERIV_N2_WS(double v,
+                                      double vt,
+                                      double u,
+                                      double & dvdp_t,
+                                      double & dvdt_p,
+                                      double & dpdt_v,
+                                      double & dudp_t,
+                                      double & dudt_p,
+                                      double & dpdt_u,
+                                      const STR_vu_SBTL_N2 & st) throw()
+{
+  PT_DERIV_JAC_N2(v, vt, u, st.jac, dvdp_t, dvdt_p, dpdt_v, dudp_t, dudt_p, dpdt_u);
+}
+//
 SBTLAPI int __stdcall PT_FLASH_DERIV_N2(double p,
                                         double t,
                                         double & v,
@@ -91,78 +316,27 @@ SBTLAPI int __stdcall PT_FLASH_DERIV_N2(double p,
                                         double & dudt_p,
                                         double & dpdt_u) throw()
 {
-  static const double df_p = 1.e-10; // rel. deviation in p
-  static const double df_t = 1.e-10; // abs. deviation in t
-
-  double tx, px, den;
-  double dtdv_u, dtdu_v, dudv_t;
-  double dpdv_u, dpdu_v, dudv_p;
-  double p_, t_;
-
   // calculate initial guesses
-  VU_TP_N2_INI(t, p, vt, u);
+  VU_PT_START_N2(p, t, vt, u);
 
-  // newtons method
-  double f_p = -1., f_t = -1., p_inv = 1. / p;
-  int icount = 0;
-  while (fabs(f_p * p_inv) > df_p || fabs(f_t) > df_t)
-  {
-    DIFF_P_VU_N2_TT(vt, u, px, dpdv_u, dpdu_v, dudv_p); // px, transformed derivatives
-    DIFF_T_VU_N2_TT(vt, u, tx, dtdv_u, dtdu_v, dudv_t); // tx, transformed derivatives
-    f_p = px - p;
-    f_t = tx - t;
-    den = dtdu_v * dpdv_u - dtdv_u * dpdu_v;
-    vt = vt + (-dtdu_v * f_p + f_t * dpdu_v) / den;
-    u = u + (-f_t * dpdv_u + dtdv_u * f_p) / den;
-    if (icount++ > ITMAX)
-    {
-      return I_ERR;
-    }
-  }
+  // newtons method, the derivatives from its last iteration if possible
+  int nit = 0;
+  JAC_SBTL_N2 jac;
+  if (PT_NEWTON_N2(p, t, vt, u, tol_PT_N2, nit, jac) != I_OK)
+    return I_ERR;
   v = exp(vt);
-  // derivatives
-  DIFF_P_VU_N2_T(vt, v, u, p_, dpdv_u, dpdu_v, dudv_p);
-  DIFF_T_VU_N2_T(vt, v, u, t_, dtdv_u, dtdu_v, dudv_t);
-  //
-  dvdp_t = 1. / (dpdv_u + dpdu_v * dudv_t);
-  dvdt_p = 1. / (dtdv_u + dtdu_v * dudv_p);
-  dpdt_v = -dvdt_p / dvdp_t;
-  //
-  dudp_t = 1. / (dpdu_v + dpdv_u / dudv_t);
-  dudt_p = 1. / (dtdu_v + dtdv_u / dudv_p);
-  dpdt_u = -dudt_p / dudp_t;
+  PT_DERIV_JAC_N2(v, vt, u, jac, dvdp_t, dvdt_p, dpdt_v, dudp_t, dudt_p, dpdt_u);
   return I_OK;
 }
 //
 SBTLAPI int
 PT_FLASH_N2_T(double p, double t, double & vt, double & u) throw()
 {
-  static const double df_p = 1.e-10; //-8   //rel. deviation in p
-  static const double df_t = 1.e-10; //-8   //abs. deviation in t
-
-  double tx, px, den;
-  double dtdv_u, dtdu_v, dudv_t;
-  double dpdv_u, dpdu_v, dudv_p;
-
   // calculate initial guesses
-  VU_TP_N2_INI(t, p, vt, u);
+  VU_PT_START_N2(p, t, vt, u);
 
   // newtons method
-  double f_p = -1., f_t = -1., p_inv = 1. / p;
-  int icount = 0;
-  while (fabs(f_p * p_inv) > df_p || fabs(f_t) > df_t)
-  {
-    DIFF_P_VU_N2_TT(vt, u, px, dpdv_u, dpdu_v, dudv_p); // px, transformed derivatives
-    DIFF_T_VU_N2_TT(vt, u, tx, dtdv_u, dtdu_v, dudv_t); // tx, transformed derivatives
-    f_p = px - p;
-    f_t = tx - t;
-    den = dtdu_v * dpdv_u - dtdv_u * dpdu_v;
-    vt = vt + (-dtdu_v * f_p + f_t * dpdu_v) / den;
-    u = u + (-f_t * dpdv_u + dtdv_u * f_p) / den;
-    if (icount++ > ITMAX)
-    {
-      return I_ERR;
-    }
-  }
-  return I_OK;
+  int nit = 0;
+  JAC_SBTL_N2 jac;
+  return PT_NEWTON_N2(p, t, vt, u, tol_PT_N2, nit, jac);
 }
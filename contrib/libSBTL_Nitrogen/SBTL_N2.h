@@ -25,6 +25,20 @@
 #pragma once
 //
 //-----------------------------------------------------------------------------
+// thread safety
+//-----------------------------------------------------------------------------
+//
+// All SBTLAPI functions except the SBTL_TAB_N2_* table functions are reentrant and may be called
+// concurrently from any number of threads: they only read the coefficient tables and their
+// function-local static constants and keep no other state. The *_WS functions keep their state in
+// the STR_vu_SBTL_N2 passed by the caller, which must not be shared between threads, and the
+// functions with the suffix _H likewise the cell hint. The SBTL_TAB_N2_* functions
+// replace the tables and set the error message, so they must not run concurrently with each other
+// or with any other function, i.e. the tables have to be loaded before the threads evaluate
+// properties. The functions with the suffix _NP split arrays of state points across threads
+// themselves.
+//
+//-----------------------------------------------------------------------------
 // return values (error flags)
 //-----------------------------------------------------------------------------
 //
@@ -32,6 +46,149 @@
 #define I_OK  0
 #define I_ERR 1
 
+//-----------------------------------------------------------------------------
+// range of validity of the splines (gaseous nitrogen)
+//-----------------------------------------------------------------------------
+//
+#define PMIN_N2 0.0005  // MPa
+#define PMAX_N2 100.    // MPa
+#define TMIN_N2 250.    // K
+#define TMAX_N2 1300.   // K
+
+//-----------------------------------------------------------------------------
+// property indices of the fused forward function DIFF_ALL_VU_N2
+//-----------------------------------------------------------------------------
+//
+#define IALL_P      0   // pressure                 MPa
+#define IALL_T      1   // temperature              K
+#define IALL_S      2   // specific entropy         kJ/(kg K)
+#define IALL_W      3   // speed of sound           m/s
+#define IALL_CP     4   // isobaric heat capacity   kJ/(kg K)
+#define IALL_CV     5   // isochoric heat capacity  kJ/(kg K)
+#define IALL_ETA    6   // dynamic viscosity        Pa s
+#define IALL_LAMBDA 7   // thermal conductivity     W/(m K)
+#define NALL_VU_N2  8   // number of properties
+
+//-----------------------------------------------------------------------------
+// cell hints of the forward functions with the suffix _H: (j << 16) | i of the cell (i,j) of the
+// previous call, which is reused if it still contains the state point
+//-----------------------------------------------------------------------------
+//
+#define CELL_NONE_N2 0xFFFFFFFFu    // no hint (e.g. before the first call)
+
+//-----------------------------------------------------------------------------
+// convergence criteria of the flashes
+//-----------------------------------------------------------------------------
+//
+// Newton's method stops once the residuals at the current iterate are below the tolerances and
+// still applies the step computed there, which roughly squares the error, so the results are far
+// more accurate than the tolerances. Iterations per flash (n_it of STR_vu_SBTL_N2) and the largest
+// deviations from TOL_TIGHT_N2 for 2000 random gas states (0.0005-100 MPa, 250-1300 K), starting
+// cold from a guess 0.1 % off and warm from state points 1e-7 to 1e-3 apart in p:
+//
+//  mode            df_p   df_t   df_h   df_s   itmax  cold  warm  dv/v    du (kJ/kg)
+//  TOL_FAST_N2     1e-4   1e-2   1e-1   1e-4    4     2     1-2   1e-10   1e-8
+//  TOL_DEFAULT_N2  1e-10  1e-10  1e-8   1e-10  10     3     2-3   1e-14   5e-12
+//  TOL_TIGHT_N2    1e-13  1e-11  1e-10  1e-12  20     3-4   2-4   -       -
+//  TOL_BACKWARD_N2 1e-4   1e-2   1e-1   1e-4    4     0     0     5e-5    5e-3
+//
+// Except for TOL_BACKWARD_N2, these are far below the deviations of the splines from the equation
+// of state (about 1e-6 in v). The flashes without a struct state always use TOL_DEFAULT_N2, the
+// *_WS functions the criteria in STR_vu_SBTL_N2::tol and FLASH_VH_N2_TOL those passed to it. The
+// (p,t), (p,h) and (p,s) flashes start from the backward splines of VU_PZ_N2.cpp instead and need
+// one iteration with TOL_FAST_N2 and two with TOL_DEFAULT_N2 (three for 1.3 % of the (p,t) and
+// 0.1 % of the (p,h) and (p,s) flashes of 20000 random states). Their *_WS functions start warm
+// from the previous state point instead if it is closer than the residual bounds of the backward
+// splines, with a first step from the Jacobian of the previous flash, and then need one iteration
+// with TOL_FAST_N2 and TOL_DEFAULT_N2 and one or two with TOL_TIGHT_N2 (state points 1e-9 to 1e-6
+// apart in p). With TOL_BACKWARD_N2 they take the backward splines without any Newton iteration
+// (n_it = 0) wherever the residual bounds of their cell meet the criteria of TOL_FAST_N2, which
+// all cells of the generated tables do over the whole range of validity, at the cost of deviations
+// up to 5e-5 in vt and 5e-3 kJ/kg in u (about 1e-6 in vt typically, comparable to the splines);
+// the other flashes treat TOL_BACKWARD_N2 like TOL_FAST_N2. The backward splines do not
+// extrapolate: out of the range of validity, the flashes always take Newton's method.
+//
+#define TOL_FAST_N2    0    // explicit solvers, preconditioners: one or two Newton steps
+#define TOL_DEFAULT_N2 1    // converged to round-off in practice
+#define TOL_TIGHT_N2   2    // round-off guaranteed by the criteria, e.g. for finite differences
+#define TOL_BACKWARD_N2 3   // TOL_FAST_N2, but no Newton step where the backward splines meet it
+//
+typedef struct _TOL_SBTL_N2 {
+//
+    double df_p;    //rel. deviation in p
+    double df_t;    //abs. deviation in t       K
+    double df_h;    //abs. deviation in h       kJ/kg
+    double df_s;    //abs. deviation in s       kJ/(kg K)
+    int itmax;      //iteration limit of Newton's method (a flash fails beyond itmax + 1 iterations)
+    bool backward;  //(p,t), (p,h), (p,s): no Newton step if the backward splines meet the criteria
+// constructor
+    _TOL_SBTL_N2() { set(TOL_DEFAULT_N2); }
+// criteria of one of the TOL_*_N2 modes
+    void set(int mode) {
+        switch(mode) {
+        case TOL_FAST_N2:
+        case TOL_BACKWARD_N2:
+            df_p=1.e-4;  df_t=1.e-2;  df_h=1.e-1;  df_s=1.e-4;  itmax=4;
+            break;
+        case TOL_TIGHT_N2:
+            df_p=1.e-13; df_t=1.e-11; df_h=1.e-10; df_s=1.e-12; itmax=20;
+            break;
+        default:
+            df_p=1.e-10; df_t=1.e-10; df_h=1.e-8;  df_s=1.e-10; itmax=10;
+            break;
+        }
+        backward=(mode==TOL_BACKWARD_N2);
+    }
+} TOL_SBTL_N2;
+
+//-----------------------------------------------------------------------------
+// Jacobian of the last Newton iteration of the flashes
+//-----------------------------------------------------------------------------
+//
+// The *_WS flashes keep the derivatives of the splines at their last Newton iterate. The last
+// step is applied after the convergence check, so it is tiny once Newton has converged: if it is
+// below DX_JAC_N2 in vt (and relative to u in u), the derivative functions with the suffix _WS
+// take these derivatives instead of evaluating the splines again at the solution. Otherwise (a
+// larger last step, e.g. with TOL_FAST_N2, or no iteration with TOL_BACKWARD_N2) they evaluate the
+// splines at the solution. For the states of the table above with TOL_DEFAULT_N2, the derivatives
+// of the (p,t) and (p,s) flashes differ by at most 3e-11 (relative) from those at the solution,
+// those of the (h,s) flash by 5e-10 and those of the (p,h) flash by 4e-8, which are
+// ill-conditioned close to ideal gas behavior (h nearly independent of v at constant u); all far
+// below the accuracy of the splines.
+//
+#define DX_JAC_N2 1.e-10
+//
+typedef struct _JAC_SBTL_N2 {
+//
+    double vt;      //solution (vt,u) of the flash
+    double u;       //the derivatives belong to
+    double p;       //pressure at the last iterate, consistent with the derivatives     MPa
+    double dpdv;    //(dp/dvt)_u
+    double dpdu;    //(dp/du)_vt
+    double dzdv;    //(dz/dvt)_u and (dz/du)_vt of the second property z of the flash,
+    double dzdu;    //t (PT) or s (PS and HS), not set by the (p,h) flash
+    int iz;         //IALL_T, IALL_S or IALL_P (p only) for z, -1 if not usable
+// constructor
+    _JAC_SBTL_N2() { iz=-1; }
+// derivatives (dpdv_,dpdu_,dzdv_,dzdu_) and pressure px at the start of the last Newton step
+// (dvt,du) that ended at (vt_,u_)
+    void set(int iz_, double vt_, double u_, double dvt, double du, double px,
+             double dpdv_, double dpdu_, double dzdv_, double dzdu_) {
+        vt=vt_;
+        u=u_;
+        p=px;
+        dpdv=dpdv_;
+        dpdu=dpdu_;
+        dzdv=dzdv_;
+        dzdu=dzdu_;
+        iz=(dvt*dvt<=DX_JAC_N2*DX_JAC_N2 && du*du<=DX_JAC_N2*DX_JAC_N2*u_*u_) ? iz_ : -1;
+    }
+// whether the derivatives of p, and of z if iz_ is not IALL_P, are usable at (vt_,u_)
+    bool at(double vt_, double u_, int iz_) const {
+        return iz>=0 && (iz_==IALL_P || iz==iz_) && vt==vt_ && u==u_;
+    }
+} JAC_SBTL_N2;
+
 //-----------------------------------------------------------------------------
 // struct states
 //-----------------------------------------------------------------------------
@@ -49,6 +206,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 // - struct to be used by ireg_vu_SBTL_N2
 // - this is also used by ireg_pv_SBTL_N2 and ireg_ps_SBTL_N2
+// - the *_FLASH_N2_WS functions keep the last state point in here to skip exact
+//   repeats and to warm-start Newton's method from nearby state points
 ///////////////////////////////////////////////////////////////////////////////
 //
 typedef struct _STR_vu_SBTL_N2 {
@@ -56,17 +215,27 @@ typedef struct _STR_vu_SBTL_N2 {
     double v_;      //values below computed for this
     double u_;      //state point
     double p_;      //check p_,v_ for given (p,v), p_,s_ for given (p,s), and p_,h_ for given (p,h)
+    double t_;      //check p_,t_ for given (p,t)
     double h_;      //check p_,h_ for given (p,h) and h_,s_ for given (h,s)
     double s_;      //check p_,s_ for given (p,s) and h_,s_ for given (h,s)
 //
     double vt;      //transformed volume        (gas phase only)
+//
+    unsigned long n_hit;    //statistics of the *_FLASH_N2_WS functions: exact repeats,
+    unsigned long n_warm;   //Newton warm-started from the previous state point,
+    unsigned long n_cold;   //and started from the backward or auxiliary splines (not reset)
+    int n_it;               //Newton iterations of the last call (warm and cold start together)
+//
+    TOL_SBTL_N2 tol;        //convergence criteria of the *_FLASH_N2_WS functions (not reset)
+    JAC_SBTL_N2 jac;        //Jacobian of their last Newton iteration (not reset, keeps its (vt,u))
 // constructor
-    _STR_vu_SBTL_N2() { reset();}
+    _STR_vu_SBTL_N2() { reset(); n_hit=0; n_warm=0; n_cold=0; n_it=0;}
 // reset
     void reset() {
         v_      =ERR_VAL;
         u_      =ERR_VAL;
         p_      =ERR_VAL;
+        t_      =ERR_VAL;
         h_      =ERR_VAL;
         s_      =ERR_VAL;
         //
@@ -89,6 +258,15 @@ typedef struct _STR_vu_SBTL_N2 {
             return STR_ERR;
         }
     }
+//
+    int GetStatePT(double p, double t) {
+        if(p_==p && t_==t) {
+            return STR_PDP;
+        } else {
+            reset();
+            return STR_ERR;
+        }
+    }
 //
     int GetStatePS(double p, double s) {
         if(p_==p && s_==s) {
@@ -0,0 +1,565 @@
+///////////////////////////////////////////////////////////////////////////
+// LibSBTL_vu_N2 - SBTL library for gaseous nitrogen based on:
+//
+// Span, R., Lemmon, E.W., Jacobsen, R.T, Wagner, W., and Yokozeki, A.:
+//
+//   "A Reference Equation of State for the Thermodynamic Properties of Nitrogen for Temperatures
+//   from 63.151 to 1000 K and Pressures to 2200 MPa," J. Phys. Chem. Ref. Data, 29(6):1361-1433,
+//   2000.
+//
+// Lemmon, E.W. and Jacobsen, R.T.:
+//
+//   "Viscosity and Thermal Conductivity Equations for Nitrogen, Oxygen, Argon, and Air"
+//   Int. J. Thermophys., 25:21-69, 2004.
+//
+// Copyright (C) Idaho National Laboratory.
+// All rights reserved.
+//
+// Disclaimer:
+// The Idaho National Laboratory (INL) uses its best efforts to deliver a high-quality software and
+// to verify that the computed information is correct. However, INL makes no warranties to that
+// effect, and INL shall not be liable for any damage that may result from errors or omissions in
+// the software.
+//
+// Version: 0.9.0
+//
+// SBTL_TAB_N2 - coefficient table registry, table file reader and writer
+//
+///////////////////////////////////////////////////////////////////////////
+//
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "SBTL_N2.h"
+#include "SBTL_TAB_N2.h"
+#include "U_VH_N2_INI.h"
+#include "U_VT_N2_INI.h"
+#include "VU_N2.h"
+#include "VU_PZ_N2_TAB.h"
+#ifndef WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+//
+#ifndef SBTL_NO_EMBEDDED_TABLES
+extern const double data_PVUN2[];
+extern const double data_TVUN2[];
+extern const double data_SVUN2[];
+extern const double data_WVUN2[];
+extern const double data_CPVUN2[];
+extern const double data_CVVUN2[];
+extern const double data_ETAVUN2[];
+extern const double data_LAMBDAVUN2[];
+extern const double data_UVTN2I[];
+extern const double data_UVHN2[];
+extern const double data_VUPTN2[];
+extern const double data_VUPHN2[];
+extern const double data_VUPSN2[];
+//
+#define SBTL_TAB_N2_EMBEDDED                                                                      \
+  {                                                                                                \
+    data_PVUN2, data_TVUN2, data_SVUN2, data_WVUN2, data_CPVUN2, data_CVVUN2, data_ETAVUN2,        \
+        data_LAMBDAVUN2, data_UVTN2I, data_UVHN2, data_VUPTN2, data_VUPHN2, data_VUPSN2            \
+  }
+#else
+#define SBTL_TAB_N2_EMBEDDED                                                                      \
+  {                                                                                                \
+  }
+#endif
+//
+// the embedded tables are row-major double tables, which are copied at static initialization to
+// the cell layout and coefficient type of the library if needed (see SBTL_TAB_N2_COPY)
+#if defined(SBTL_FLOAT_TABLES) || SBTL_TILE_N2 > 1
+#define SBTL_TAB_N2_CONVERTED
+#endif
+const double * SBTL_TAB_N2_DOUBLE[NTAB_N2] = SBTL_TAB_N2_EMBEDDED;
+#ifndef SBTL_TAB_N2_CONVERTED
+const SBTL_COEF_N2 * SBTL_TAB_N2[NTAB_N2] = SBTL_TAB_N2_EMBEDDED;
+#else
+const SBTL_COEF_N2 * SBTL_TAB_N2[NTAB_N2] = {};
+#endif
+//
+const size_t SBTL_TAB_N2_COUNT[NTAB_N2] = {
+    9 * NCELL_VUN2, // forward splines
+    9 * NCELL_VUN2,
+    9 * NCELL_VUN2,
+    9 * NCELL_VUN2,
+    9 * NCELL_VUN2,
+    9 * NCELL_VUN2,
+    9 * NCELL_VUN2,
+    9 * NCELL_VUN2,
+    9 * NX1_UVTN2I * NX2_UVTN2I, // u(v,t)
+    9 * NX1_UVHN2 * NX2_UVHN2,   // u(v,h)
+    NTAB_VUPZN2,                 // backward splines
+    NTAB_VUPZN2,
+    NTAB_VUPZN2};
+//
+// maximum time in ms to wait for another process filling a shared memory segment, time in ms
+// after which an unlocked unfilled segment is abandoned, and number of attempts to create a
+// segment again
+#define SBTL_TAB_N2_SHM_WAIT  60000
+#define SBTL_TAB_N2_SHM_GRACE 100
+#define SBTL_TAB_N2_SHM_TRIES 3
+//
+static char SBTL_TAB_N2_MSG[512] = "";
+//
+static int
+SBTL_TAB_N2_FAIL(const char * msg, const char * path) throw()
+{
+  snprintf(SBTL_TAB_N2_MSG, sizeof(SBTL_TAB_N2_MSG), "%s: %s", path, msg);
+  return I_ERR;
+}
+//
+// 64 bit FNV-1a hash, continuing 'hash' of the preceding bytes
+static uint64_t
+SBTL_TAB_N2_FNV(const unsigned char * data,
+                size_t n,
+                uint64_t hash = 14695981039346656037ull) throw()
+{
+  for (size_t k = 0; k < n; k++)
+  {
+    hash ^= data[k];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+//
+// byte offset of the coefficients of each table
+static void
+SBTL_TAB_N2_LAYOUT(SBTL_TAB_N2_ENTRY * dir, size_t & size) throw()
+{
+  size = sizeof(SBTL_TAB_N2_HEADER) + NTAB_N2 * sizeof(SBTL_TAB_N2_ENTRY);
+  for (int k = 0; k < NTAB_N2; k++)
+  {
+    size = (size + SBTL_TAB_N2_ALIGN - 1) / SBTL_TAB_N2_ALIGN * SBTL_TAB_N2_ALIGN;
+    dir[k].offset = size;
+    dir[k].count = SBTL_TAB_N2_COUNT[k];
+    size += SBTL_TAB_N2_COUNT[k] * sizeof(SBTL_COEF_N2);
+  }
+}
+//
+// number of coefficients of table k in the cell layout with tiles of 'tile' cells
+static size_t
+SBTL_TAB_N2_NCOEF(int k, uint32_t tile) throw()
+{
+  return k <= ITAB_LAMBDAVUN2 ? 9 * NCELL_TILE_VUN2((size_t)tile) : SBTL_TAB_N2_COUNT[k];
+}
+//
+// copies table k of double coefficients with tiles of 'tile' cells to 'dst' in the cell layout of
+// the library
+template <typename COEF>
+static void
+SBTL_TAB_N2_CELLS(COEF * dst, const double * src, int k, uint32_t tile) throw()
+{
+  if (k > ITAB_LAMBDAVUN2 || tile == SBTL_TILE_N2)
+  {
+    for (size_t l = 0; l < SBTL_TAB_N2_COUNT[k]; l++)
+      dst[l] = (COEF)src[l];
+    return;
+  }
+  memset(dst, 0, SBTL_TAB_N2_COUNT[k] * sizeof(COEF));
+  for (unsigned int j = 0; j < NX2_VUN2; j++)
+    for (unsigned int i = 0; i < NX1_VUN2; i++)
+    {
+      const double * val = &src[OFFSET_TILE_VU_N2(i, j, tile)];
+      COEF * cell = &dst[OFFSET_VU_N2(i, j)];
+      for (int m = 0; m < 9; m++)
+        cell[m] = (COEF)val[m];
+    }
+}
+//
+// copies of the double tables owned by the registry
+static void * SBTL_TAB_N2_PRIVATE = NULL;
+//
+// uses copies of the double tables 'tab' with tiles of 'tile' cells in the cell layout of the
+// library (SBTL_TAB_N2_DOUBLE, if the layout differs) and rounded to float (SBTL_TAB_N2, with
+// SBTL_FLOAT_TABLES); I_OK or I_ERR
+static int
+SBTL_TAB_N2_COPY(const double * const * tab, uint32_t tile) throw()
+{
+  const bool tiled = tile != SBTL_TILE_N2;
+  const bool rounded = sizeof(SBTL_COEF_N2) != sizeof(double);
+  size_t n = 0;
+  for (int k = 0; k < NTAB_N2; k++)
+    n += SBTL_TAB_N2_COUNT[k];
+  char * copy = (char *)malloc(n * ((tiled ? sizeof(double) : 0) + (rounded ? sizeof(float) : 0)));
+  if (!copy)
+    return I_ERR;
+
+  double * dst_double = (double *)copy;
+  SBTL_COEF_N2 * dst = (SBTL_COEF_N2 *)(copy + (tiled ? n * sizeof(double) : 0));
+  for (int k = 0; k < NTAB_N2; k++)
+  {
+    const double * src = tab[k];
+    if (tiled)
+    {
+      SBTL_TAB_N2_CELLS(dst_double, src, k, tile);
+      src = dst_double;
+      dst_double += SBTL_TAB_N2_COUNT[k];
+    }
+    SBTL_TAB_N2_DOUBLE[k] = src;
+#ifdef SBTL_FLOAT_TABLES
+    SBTL_TAB_N2_CELLS(dst, src, k, SBTL_TILE_N2);
+    SBTL_TAB_N2[k] = dst;
+    dst += SBTL_TAB_N2_COUNT[k];
+#else
+    SBTL_TAB_N2[k] = src;
+    (void)dst;
+#endif
+  }
+  free(SBTL_TAB_N2_PRIVATE);
+  SBTL_TAB_N2_PRIVATE = copy;
+  return I_OK;
+}
+#if defined(SBTL_TAB_N2_CONVERTED) && !defined(SBTL_NO_EMBEDDED_TABLES)
+static const int SBTL_TAB_N2_COPIED = SBTL_TAB_N2_COPY(SBTL_TAB_N2_DOUBLE, 1);
+#endif
+//
+// NULL if 'image' is a valid table file image of 'size' bytes, the reason otherwise
+static const char *
+SBTL_TAB_N2_CHECK(const unsigned char * image, size_t size) throw()
+{
+  const SBTL_TAB_N2_HEADER * hdr = (const SBTL_TAB_N2_HEADER *)image;
+  const SBTL_TAB_N2_ENTRY * dir = (const SBTL_TAB_N2_ENTRY *)(image + sizeof(SBTL_TAB_N2_HEADER));
+  if (size < sizeof(SBTL_TAB_N2_HEADER) ||
+      memcmp(hdr->magic, SBTL_TAB_N2_MAGIC, sizeof(SBTL_TAB_N2_MAGIC)) != 0)
+    return "not an SBTL_N2 table file";
+  if (hdr->bom != SBTL_TAB_N2_BOM)
+    return "table file has a different byte order";
+  if (hdr->version != SBTL_TAB_N2_VERSION)
+    return "unsupported table file version";
+  if (hdr->ntab != NTAB_N2 ||
+      size < sizeof(SBTL_TAB_N2_HEADER) + NTAB_N2 * sizeof(SBTL_TAB_N2_ENTRY))
+    return "wrong number of tables";
+  // float tables can only be used as such, double tables are converted if needed
+  if (hdr->coef_size != sizeof(SBTL_COEF_N2) && hdr->coef_size != sizeof(double))
+    return "float tables need a library built with SBTL_FLOAT_TABLES";
+  if (hdr->tile < 1 || hdr->tile > NX2_VUN2)
+    return "unsupported cell layout";
+  if (hdr->coef_size != sizeof(double) && hdr->tile != SBTL_TILE_N2)
+    return "float tables need a library built with the same cell layout (SBTL_TILED_TABLES)";
+  for (int k = 0; k < NTAB_N2; k++)
+    if (dir[k].count != SBTL_TAB_N2_NCOEF(k, hdr->tile) || dir[k].offset % hdr->coef_size != 0 ||
+        dir[k].offset > size || dir[k].count * hdr->coef_size > size - dir[k].offset)
+      return "corrupt table directory";
+  if (SBTL_TAB_N2_FNV(image + sizeof(SBTL_TAB_N2_HEADER), size - sizeof(SBTL_TAB_N2_HEADER)) !=
+      hdr->checksum)
+    return "checksum mismatch";
+  return NULL;
+}
+//
+// use the tables of a validated image from now on (NULL or the reason of the failure)
+static const char *
+SBTL_TAB_N2_USE(const unsigned char * image) throw()
+{
+  const SBTL_TAB_N2_HEADER * hdr = (const SBTL_TAB_N2_HEADER *)image;
+  const SBTL_TAB_N2_ENTRY * dir = (const SBTL_TAB_N2_ENTRY *)(image + sizeof(SBTL_TAB_N2_HEADER));
+  if (hdr->coef_size != sizeof(SBTL_COEF_N2) || hdr->tile != SBTL_TILE_N2)
+  {
+    // double tables of another coefficient type or cell layout (see SBTL_TAB_N2_CHECK)
+    const double * tab[NTAB_N2];
+    for (int k = 0; k < NTAB_N2; k++)
+      tab[k] = (const double *)(image + dir[k].offset);
+    if (SBTL_TAB_N2_COPY(tab, hdr->tile) != I_OK)
+      return "out of memory";
+    SBTL_TAB_N2_MSG[0] = '\0';
+    return NULL;
+  }
+  for (int k = 0; k < NTAB_N2; k++)
+  {
+    SBTL_TAB_N2[k] = (const SBTL_COEF_N2 *)(image + dir[k].offset);
+    SBTL_TAB_N2_DOUBLE[k] =
+        hdr->coef_size == sizeof(double) ? (const double *)(image + dir[k].offset) : NULL;
+  }
+  SBTL_TAB_N2_MSG[0] = '\0';
+  return NULL;
+}
+//
+// header of the table file image of the current tables, the checksum is hashed from the tables
+// directly, so no image is needed
+static void
+SBTL_TAB_N2_HEAD(SBTL_TAB_N2_HEADER & hdr) throw()
+{
+  SBTL_TAB_N2_ENTRY dir[NTAB_N2];
+  size_t size;
+  SBTL_TAB_N2_LAYOUT(dir, size);
+
+  static const unsigned char zero[SBTL_TAB_N2_ALIGN] = {0};
+  uint64_t hash = SBTL_TAB_N2_FNV((const unsigned char *)dir, sizeof(dir));
+  size_t end = sizeof(SBTL_TAB_N2_HEADER) + sizeof(dir);
+  for (int k = 0; k < NTAB_N2; k++)
+  {
+    hash = SBTL_TAB_N2_FNV(zero, dir[k].offset - end, hash);
+    hash = SBTL_TAB_N2_FNV(
+        (const unsigned char *)SBTL_TAB_N2[k], dir[k].count * sizeof(SBTL_COEF_N2), hash);
+    end = dir[k].offset + dir[k].count * sizeof(SBTL_COEF_N2);
+  }
+
+  memset(&hdr, 0, sizeof(hdr));
+  memcpy(hdr.magic, SBTL_TAB_N2_MAGIC, sizeof(SBTL_TAB_N2_MAGIC));
+  hdr.version = SBTL_TAB_N2_VERSION;
+  hdr.bom = SBTL_TAB_N2_BOM;
+  hdr.ntab = NTAB_N2;
+  hdr.coef_size = sizeof(SBTL_COEF_N2);
+  hdr.tile = SBTL_TILE_N2;
+  hdr.checksum = hash;
+}
+//
+// write directory and data of the current tables to 'image' and return the header
+static void
+SBTL_TAB_N2_FILL(unsigned char * image, SBTL_TAB_N2_HEADER & hdr) throw()
+{
+  SBTL_TAB_N2_ENTRY dir[NTAB_N2];
+  size_t size;
+  SBTL_TAB_N2_LAYOUT(dir, size);
+
+  memset(image, 0, size);
+  memcpy(image + sizeof(SBTL_TAB_N2_HEADER), dir, sizeof(dir));
+  for (int k = 0; k < NTAB_N2; k++)
+    memcpy(image + dir[k].offset, SBTL_TAB_N2[k], dir[k].count * sizeof(SBTL_COEF_N2));
+  SBTL_TAB_N2_HEAD(hdr);
+}
+//
+SBTLAPI int __stdcall SBTL_TAB_N2_READY() throw()
+{
+  for (int k = 0; k < NTAB_N2; k++)
+    if (!SBTL_TAB_N2[k])
+      return I_ERR;
+  return I_OK;
+}
+//
+SBTLAPI int __stdcall SBTL_TAB_N2_LOAD(const char * path) throw()
+{
+  size_t size;
+  const unsigned char * image;
+
+#ifndef WIN32
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return SBTL_TAB_N2_FAIL("cannot open file", path);
+  struct stat st;
+  if (fstat(fd, &st) != 0)
+  {
+    close(fd);
+    return SBTL_TAB_N2_FAIL("cannot stat file", path);
+  }
+  size = st.st_size;
+  if (size < sizeof(SBTL_TAB_N2_HEADER))
+  {
+    close(fd);
+    return SBTL_TAB_N2_FAIL("file too short", path);
+  }
+  void * map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+    return SBTL_TAB_N2_FAIL("cannot map file", path);
+  image = (const unsigned char *)map;
+#else
+  // no mmap: read the file into memory
+  FILE * f = fopen(path, "rb");
+  if (!f)
+    return SBTL_TAB_N2_FAIL("cannot open file", path);
+  fseek(f, 0, SEEK_END);
+  size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  unsigned char * buf = (unsigned char *)malloc(size > 0 ? size : 1);
+  const bool ok = buf && fread(buf, 1, size, f) == size;
+  fclose(f);
+  if (!ok || size < sizeof(SBTL_TAB_N2_HEADER))
+  {
+    free(buf);
+    return SBTL_TAB_N2_FAIL("cannot read file", path);
+  }
+  image = buf;
+#endif
+
+  // validate header, directory and checksum before using any table
+  const char * err = SBTL_TAB_N2_CHECK(image, size);
+  if (!err)
+    err = SBTL_TAB_N2_USE(image);
+  if (err)
+  {
+#ifndef WIN32
+    munmap((void *)image, size);
+#else
+    free((void *)image);
+#endif
+    return SBTL_TAB_N2_FAIL(err, path);
+  }
+  return I_OK;
+}
+//
+SBTLAPI int __stdcall SBTL_TAB_N2_WRITE(const char * path) throw()
+{
+  if (SBTL_TAB_N2_READY() != I_OK)
+    return SBTL_TAB_N2_FAIL("no tables available to write", path);
+
+  const size_t size = SBTL_TAB_N2_SIZE();
+  unsigned char * image = (unsigned char *)malloc(size);
+  if (!image)
+    return SBTL_TAB_N2_FAIL("out of memory", path);
+  SBTL_TAB_N2_IMAGE(image);
+
+  FILE * f = fopen(path, "wb");
+  bool ok = f && fwrite(image, 1, size, f) == size;
+  if (f && fclose(f) != 0)
+    ok = false;
+  free(image);
+  if (!ok)
+    return SBTL_TAB_N2_FAIL("cannot write file", path);
+  SBTL_TAB_N2_MSG[0] = '\0';
+  return I_OK;
+}
+//
+SBTLAPI size_t __stdcall SBTL_TAB_N2_SIZE() throw()
+{
+  SBTL_TAB_N2_ENTRY dir[NTAB_N2];
+  size_t size;
+  SBTL_TAB_N2_LAYOUT(dir, size);
+  return size;
+}
+//
+SBTLAPI int __stdcall SBTL_TAB_N2_IMAGE(void * image) throw()
+{
+  if (SBTL_TAB_N2_READY() != I_OK)
+    return SBTL_TAB_N2_FAIL("no tables available", "SBTL_TAB_N2_IMAGE");
+  SBTL_TAB_N2_HEADER hdr;
+  SBTL_TAB_N2_FILL((unsigned char *)image, hdr);
+  memcpy(image, &hdr, sizeof(hdr));
+  return I_OK;
+}
+//
+SBTLAPI int __stdcall SBTL_TAB_N2_ATTACH(const void * image,
+                                         size_t size,
+                                         const char * name) throw()
+{
+  const char * err = SBTL_TAB_N2_CHECK((const unsigned char *)image, size);
+  if (!err)
+    err = SBTL_TAB_N2_USE((const unsigned char *)image);
+  if (err)
+    return SBTL_TAB_N2_FAIL(err, name);
+  return I_OK;
+}
+//
+#ifndef WIN32
+// waits until the segment 'fd' is filled and maps it; NULL if it holds the tables with header
+// 'cur', the reason otherwise, with 'stale' telling whether the segment has to be created again
+static const char *
+SBTL_TAB_N2_SHM_WAIT_FILLED(
+    int fd, size_t size, const SBTL_TAB_N2_HEADER & cur, void *& map, bool & stale) throw()
+{
+  map = MAP_FAILED;
+  stale = false;
+  for (int wait_ms = 0;; wait_ms++)
+  {
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+      return "cannot stat shared memory segment";
+    if (st.st_size == (off_t)size && map == MAP_FAILED)
+    {
+      map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+      if (map == MAP_FAILED)
+        return "cannot map shared memory segment";
+    }
+    // the header is written last
+    if (map != MAP_FAILED && ((const volatile char *)map)[0] != '\0')
+      break;
+    // the creator holds the lock while filling, a segment left unfilled is abandoned
+    if (wait_ms >= SBTL_TAB_N2_SHM_GRACE && flock(fd, LOCK_SH | LOCK_NB) == 0)
+    {
+      flock(fd, LOCK_UN);
+      stale = true;
+      return "shared memory segment was abandoned before it was filled";
+    }
+    if (wait_ms >= SBTL_TAB_N2_SHM_WAIT)
+      return "timeout waiting for another process to fill the shared memory segment";
+    usleep(1000);
+  }
+  __sync_synchronize();
+
+  // a segment of another library build or with other tables is stale
+  const char * err = SBTL_TAB_N2_CHECK((const unsigned char *)map, size);
+  if (!err && memcmp(map, &cur, sizeof(cur)) != 0)
+    err = "shared memory segment holds other tables";
+  stale = err != NULL;
+  return err;
+}
+#endif
+//
+SBTLAPI int __stdcall SBTL_TAB_N2_SHM(const char * name) throw()
+{
+#ifndef WIN32
+  if (SBTL_TAB_N2_READY() != I_OK)
+    return SBTL_TAB_N2_FAIL("no tables available to fill the shared memory segment", name);
+  const size_t size = SBTL_TAB_N2_SIZE();
+  SBTL_TAB_N2_HEADER cur;
+  SBTL_TAB_N2_HEAD(cur);
+
+  // a stale segment is removed and created again; the retries cover other processes doing the same
+  const char * err = NULL;
+  for (int attempt = 0; attempt < SBTL_TAB_N2_SHM_TRIES; attempt++)
+  {
+    // the first process creates and fills the segment under a lock, the header is written last
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd >= 0)
+    {
+      flock(fd, LOCK_EX);
+      void * map = MAP_FAILED;
+      if (ftruncate(fd, size) == 0)
+        map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (map == MAP_FAILED)
+      {
+        close(fd);
+        shm_unlink(name);
+        return SBTL_TAB_N2_FAIL("cannot create shared memory segment", name);
+      }
+      unsigned char * image = (unsigned char *)map;
+      SBTL_TAB_N2_HEADER hdr;
+      SBTL_TAB_N2_FILL(image, hdr);
+      memcpy(image + sizeof(hdr.magic), (const char *)&hdr + sizeof(hdr.magic),
+             sizeof(hdr) - sizeof(hdr.magic));
+      __sync_synchronize();
+      memcpy(image, hdr.magic, sizeof(hdr.magic));
+      close(fd);
+      // the pages stay shared, but this process only reads them from now on
+      mprotect(map, size, PROT_READ);
+      SBTL_TAB_N2_USE(image);
+      return I_OK;
+    }
+    if (errno != EEXIST)
+      return SBTL_TAB_N2_FAIL("cannot open shared memory segment", name);
+
+    // all others wait until the creator has filled it
+    fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0 && errno == ENOENT)
+      continue;
+    if (fd < 0)
+      return SBTL_TAB_N2_FAIL("cannot open shared memory segment", name);
+    void * map;
+    bool stale;
+    err = SBTL_TAB_N2_SHM_WAIT_FILLED(fd, size, cur, map, stale);
+    close(fd);
+    if (!err)
+      err = SBTL_TAB_N2_USE((const unsigned char *)map);
+    if (!err)
+      return I_OK;
+    if (map != MAP_FAILED)
+      munmap(map, size);
+    if (!stale)
+      break;
+    shm_unlink(name);
+  }
+  return SBTL_TAB_N2_FAIL(err ? err : "cannot open shared memory segment", name);
+#else
+  return SBTL_TAB_N2_FAIL("POSIX shared memory is not available", name);
+#endif
+}
+//
+SBTLAPI const char * __stdcall SBTL_TAB_N2_ERROR() throw()
+{
+  return SBTL_TAB_N2_MSG;
+}
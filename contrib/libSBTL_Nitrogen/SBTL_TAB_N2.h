@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////
+// LibSBTL_vu_N2 - SBTL library for gaseous nitrogen based on:
+//
+// Span, R., Lemmon, E.W., Jacobsen, R.T, Wagner, W., and Yokozeki, A.:
+//
+//   "A Reference Equation of State for the Thermodynamic Properties of Nitrogen for Temperatures
+//   from 63.151 to 1000 K and Pressures to 2200 MPa," J. Phys. Chem. Ref. Data, 29(6):1361-1433,
+//   2000.
+//
+// Lemmon, E.W. and Jacobsen, R.T.:
+//
+//   "Viscosity and Thermal Conductivity Equations for Nitrogen, Oxygen, Argon, and Air"
+//   Int. J. Thermophys., 25:21-69, 2004.
+//
+// Copyright (C) Idaho National Laboratory.
+// All rights reserved.
+//
+// Disclaimer:
+// The Idaho National Laboratory (INL) uses its best efforts to deliver a high-quality software and
+// to verify that the computed information is correct. However, INL makes no warranties to that
+// effect, and INL shall not be liable for any damage that may result from errors or omissions in
+// the software.
+//
+// Version: 0.9.0
+//
+// SBTL_TAB_N2.h - coefficient tables of the splines and their binary file format
+//
+///////////////////////////////////////////////////////////////////////////
+//
+#pragma once
+//
+#include "stddef.h"
+#include "stdint.h"
+#include "SBTL_call_conv.h"
+//
+// table ids
+#define ITAB_PVUN2      0   // forward spline p(v,u)
+#define ITAB_TVUN2      1   // forward spline t(v,u)
+#define ITAB_SVUN2      2   // forward spline s(v,u)
+#define ITAB_WVUN2      3   // forward spline w(v,u)
+#define ITAB_CPVUN2     4   // forward spline cp(v,u)
+#define ITAB_CVVUN2     5   // forward spline cv(v,u)
+#define ITAB_ETAVUN2    6   // forward spline eta(v,u)
+#define ITAB_LAMBDAVUN2 7   // forward spline lambda(v,u)
+#define ITAB_UVTN2I     8   // initial guess of u(v,t)
+#define ITAB_UVHN2      9   // initial guess of u(v,h)
+#define ITAB_VUPTN2    10   // backward splines vt(p,t) and u(p,t)
+#define ITAB_VUPHN2    11   // backward splines vt(p,h) and u(p,h)
+#define ITAB_VUPSN2    12   // backward splines vt(p,s) and u(p,s)
+#define NTAB_N2        13   // number of tables
+//
+// type of the coefficients: float if built with SBTL_FLOAT_TABLES, which halves the memory traffic
+// of the spline evaluations (the splines are still evaluated in double precision)
+#ifdef SBTL_FLOAT_TABLES
+typedef float SBTL_COEF_N2;
+#else
+typedef double SBTL_COEF_N2;
+#endif
+//
+// cell layout of the forward splines: the cells (i,j) are stored row-major (i fastest) or, if built
+// with SBTL_TILED_TABLES, in tiles of SBTL_TILE_N2 x SBTL_TILE_N2 cells, so that the neighbours in
+// j of a cell are close in memory; see OFFSET_VU_N2. The initial guess and backward splines stay
+// row-major.
+#ifdef SBTL_TILED_TABLES
+#define SBTL_TILE_N2 8
+#else
+#define SBTL_TILE_N2 1
+#endif
+//
+// coefficient tables used by the spline functions: the arrays compiled into the library (or their
+// copies in the cell layout and coefficient type of the library) or, after SBTL_TAB_N2_LOAD, the
+// tables of a table file (all NULL if built with SBTL_NO_EMBEDDED_TABLES). The single property
+// functions P_VU_N2, DIFF_P_VU_N2 etc. always evaluate the compiled arrays; Z_VU_N2, DIFF_Z_VU_N2
+// etc. (ALL_VU_N2.cpp) evaluate these tables like the fused functions and the flashes.
+extern const SBTL_COEF_N2 * SBTL_TAB_N2[NTAB_N2];
+//
+// double precision tables SBTL_TAB_N2 was rounded from (identical to SBTL_TAB_N2 unless built with
+// SBTL_FLOAT_TABLES, NULL after loading float tables)
+extern const double * SBTL_TAB_N2_DOUBLE[NTAB_N2];
+//
+// number of coefficients of each table
+extern const size_t SBTL_TAB_N2_COUNT[NTAB_N2];
+//
+//-----------------------------------------------------------------------------
+// table file (native byte order):
+//   header     SBTL_TAB_N2_HEADER
+//   directory  NTAB_N2 x SBTL_TAB_N2_ENTRY, in the order of the table ids
+//   data       the coefficients (double or float) of each table in the cell layout of the
+//              library that wrote it, starting at a multiple of SBTL_TAB_N2_ALIGN bytes
+// The checksum is the 64 bit FNV-1a hash of all bytes following the header.
+//-----------------------------------------------------------------------------
+//
+#define SBTL_TAB_N2_MAGIC   "SBTL_N2"
+#define SBTL_TAB_N2_VERSION 4
+#define SBTL_TAB_N2_BOM     0x01020304u
+#define SBTL_TAB_N2_ALIGN   64
+//
+typedef struct _SBTL_TAB_N2_HEADER {
+    char magic[8];          // SBTL_TAB_N2_MAGIC
+    uint32_t version;       // SBTL_TAB_N2_VERSION
+    uint32_t bom;           // SBTL_TAB_N2_BOM as written (detects a different byte order)
+    uint32_t ntab;          // NTAB_N2
+    uint32_t coef_size;     // size of a coefficient in bytes (8 or 4)
+    uint32_t tile;          // SBTL_TILE_N2 of the cell layout (1: row-major)
+    uint32_t reserved;
+    uint64_t checksum;      // FNV-1a of directory and data
+} SBTL_TAB_N2_HEADER;
+//
+typedef struct _SBTL_TAB_N2_ENTRY {
+    uint64_t offset;        // byte offset of the coefficients from the start of the file
+    uint64_t count;         // number of coefficients
+} SBTL_TAB_N2_ENTRY;
+//
+// I_OK if all tables are available
+SBTLAPI int __stdcall SBTL_TAB_N2_READY() throw();
+//
+// maps a table file read-only and uses its tables from then on (I_OK or I_ERR); the mapping is
+// shared through the page cache by all processes using the same file and is never unmapped. Double
+// tables of another cell layout, or with SBTL_FLOAT_TABLES, are converted to a private copy.
+SBTLAPI int __stdcall SBTL_TAB_N2_LOAD(const char * path) throw();
+//
+// writes the current tables to a table file, with coefficients of type SBTL_COEF_N2 in the cell
+// layout of the library (I_OK or I_ERR)
+SBTLAPI int __stdcall SBTL_TAB_N2_WRITE(const char * path) throw();
+//
+// size in bytes of a table file image
+SBTLAPI size_t __stdcall SBTL_TAB_N2_SIZE() throw();
+//
+// writes the table file image of the current tables to 'image' of SBTL_TAB_N2_SIZE() bytes, e.g.
+// memory shared by several processes (I_OK or I_ERR)
+SBTLAPI int __stdcall SBTL_TAB_N2_IMAGE(void * image) throw();
+//
+// validates a table file image and uses its tables from then on (I_OK or I_ERR); unless converted
+// as by SBTL_TAB_N2_LOAD, the image is not copied and must stay valid as long as the tables are
+// used, 'name' is used in the error message
+SBTLAPI int __stdcall SBTL_TAB_N2_ATTACH(const void * image,
+                                         size_t size,
+                                         const char * name) throw();
+//
+// uses the tables of the POSIX shared memory segment 'name' (I_OK or I_ERR): the first process
+// creates and fills it with the current tables, all others map it read-only once filled. The
+// segment outlives the processes, so later runs attach directly until it is removed (shm_unlink).
+// A segment whose header differs from that of the current tables (other tables, table file or
+// library build), or that was abandoned before it was filled, is removed and created again
+SBTLAPI int __stdcall SBTL_TAB_N2_SHM(const char * name) throw();
+//
+// description of the last error of the functions above
+SBTLAPI const char * __stdcall SBTL_TAB_N2_ERROR() throw();
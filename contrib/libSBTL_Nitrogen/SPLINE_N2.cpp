@@ -0,0 +1,165 @@
+///////////////////////////////////////////////////////////////////////////
+// LibSBTL_vu_N2 - SBTL library for gaseous nitrogen based on:
+//
+// Span, R., Lemmon, E.W., Jacobsen, R.T, Wagner, W., and Yokozeki, A.:
+//
+//   "A Reference Equation of State for the Thermodynamic Properties of Nitrogen for Temperatures
+//   from 63.151 to 1000 K and Pressures to 2200 MPa," J. Phys. Chem. Ref. Data, 29(6):1361-1433,
+//   2000.
+//
+// Lemmon, E.W. and Jacobsen, R.T.:
+//
+//   "Viscosity and Thermal Conductivity Equations for Nitrogen, Oxygen, Argon, and Air"
+//   Int. J. Thermophys., 25:21-69, 2004.
+//
+// Copyright (C) Idaho National Laboratory.
+// All rights reserved.
+//
+// Disclaimer:
+// The Idaho National Laboratory (INL) uses its best efforts to deliver a high-quality software and
+// to verify that the computed information is correct. However, INL makes no warranties to that
+// effect, and INL shall not be liable for any damage that may result from errors or omissions in
+// the software.
+//
+// Version: 0.9.0
+//
+// SPLINE_N2 - vectorized evaluation of biquadratic spline cells
+//
+///////////////////////////////////////////////////////////////////////////
+//
+#include "stdlib.h"
+#include "string.h"
+#include "SBTL_call_conv.h"
+#include "SPLINE_N2.h"
+//
+// runtime dispatch needs the GCC/Clang target attributes and cpu builtins
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SPLINE_N2_X86
+#include "immintrin.h"
+#endif
+//
+static void SPLINE_N2_N_SCALAR(const SBTL_COEF_N2 *data, const int *offset, const double *dx1, const double *dx2, double *z, size_t n) throw()
+{
+    for(size_t k=0; k<n; k++) {
+        const SBTL_COEF_N2 *val=&data[offset[k]];
+        z[k]=val[0]+dx2[k]*(val[1]+dx2[k]*val[2])+dx1[k]*(val[3]+dx2[k]*(val[4]+dx2[k]*val[5])+dx1[k]*(val[6]+dx2[k]*(val[7]+dx2[k]*val[8])));
+    }
+}
+//
+#ifdef SPLINE_N2_X86
+//
+// gathers of one coefficient of four cells (masked form: the plain gathers leave their source
+// operand undefined)
+__attribute__((target("avx2,fma"))) static inline __m256d GATHER_AVX2(const double *data, __m128i off) throw()
+{
+    const __m256d all=_mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), data, off, all, 8);
+}
+//
+// float coefficients (SBTL_FLOAT_TABLES) are widened after the gather
+__attribute__((target("avx2,fma"))) static inline __m256d GATHER_AVX2(const float *data, __m128i off) throw()
+{
+    const __m128 all=_mm_castsi128_ps(_mm_set1_epi32(-1));
+    return _mm256_cvtps_pd(_mm_mask_i32gather_ps(_mm_setzero_ps(), data, off, all, 4));
+}
+//
+__attribute__((target("avx2,fma"))) static void SPLINE_N2_N_AVX2(const SBTL_COEF_N2 *data, const int *offset, const double *dx1, const double *dx2, double *z, size_t n) throw()
+{
+    size_t k=0;
+    for(; k+4<=n; k+=4) {
+        const __m128i off=_mm_loadu_si128((const __m128i *)(offset+k));
+        const __m256d x1=_mm256_loadu_pd(dx1+k);
+        const __m256d x2=_mm256_loadu_pd(dx2+k);
+// Horner form in dx2 for each power of dx1, then in dx1
+        __m256d r2=_mm256_fmadd_pd(x2, GATHER_AVX2(data+8, off), GATHER_AVX2(data+7, off));
+        r2=_mm256_fmadd_pd(x2, r2, GATHER_AVX2(data+6, off));
+        __m256d r1=_mm256_fmadd_pd(x2, GATHER_AVX2(data+5, off), GATHER_AVX2(data+4, off));
+        r1=_mm256_fmadd_pd(x2, r1, GATHER_AVX2(data+3, off));
+        __m256d r0=_mm256_fmadd_pd(x2, GATHER_AVX2(data+2, off), GATHER_AVX2(data+1, off));
+        r0=_mm256_fmadd_pd(x2, r0, GATHER_AVX2(data, off));
+        r1=_mm256_fmadd_pd(x1, r2, r1);
+        _mm256_storeu_pd(z+k, _mm256_fmadd_pd(x1, r1, r0));
+    }
+// the remainder and the callers are SSE code: avoid the AVX-SSE transition penalties
+    _mm256_zeroupper();
+    SPLINE_N2_N_SCALAR(data, offset+k, dx1+k, dx2+k, z+k, n-k);
+}
+//
+// gathers of one coefficient of eight cells
+__attribute__((target("avx512f"))) static inline __m512d GATHER_AVX512(const double *data, __m256i off) throw()
+{
+    return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, off, data, 8);
+}
+//
+__attribute__((target("avx512f"))) static inline __m512d GATHER_AVX512(const float *data, __m256i off) throw()
+{
+    const __m256 all=_mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    const __m256 z=_mm256_mask_i32gather_ps(_mm256_setzero_ps(), data, off, all, 4);
+// zero-masked form: the plain conversion also leaves its source operand undefined
+    return _mm512_maskz_cvtps_pd(0xFF, z);
+}
+//
+__attribute__((target("avx512f"))) static void SPLINE_N2_N_AVX512(const SBTL_COEF_N2 *data, const int *offset, const double *dx1, const double *dx2, double *z, size_t n) throw()
+{
+    size_t k=0;
+    for(; k+8<=n; k+=8) {
+        const __m256i off=_mm256_loadu_si256((const __m256i *)(offset+k));
+        const __m512d x1=_mm512_loadu_pd(dx1+k);
+        const __m512d x2=_mm512_loadu_pd(dx2+k);
+// Horner form in dx2 for each power of dx1, then in dx1
+        __m512d r2=_mm512_fmadd_pd(x2, GATHER_AVX512(data+8, off), GATHER_AVX512(data+7, off));
+        r2=_mm512_fmadd_pd(x2, r2, GATHER_AVX512(data+6, off));
+        __m512d r1=_mm512_fmadd_pd(x2, GATHER_AVX512(data+5, off), GATHER_AVX512(data+4, off));
+        r1=_mm512_fmadd_pd(x2, r1, GATHER_AVX512(data+3, off));
+        __m512d r0=_mm512_fmadd_pd(x2, GATHER_AVX512(data+2, off), GATHER_AVX512(data+1, off));
+        r0=_mm512_fmadd_pd(x2, r0, GATHER_AVX512(data, off));
+        r1=_mm512_fmadd_pd(x1, r2, r1);
+        _mm512_storeu_pd(z+k, _mm512_fmadd_pd(x1, r1, r0));
+    }
+    SPLINE_N2_N_AVX2(data, offset+k, dx1+k, dx2+k, z+k, n-k);
+}
+//
+#endif
+//
+// highest instruction set supported by the CPU, limited by SBTL_N2_SIMD
+static int SPLINE_N2_SELECT() throw()
+{
+    int simd=SIMD_SCALAR;
+#ifdef SPLINE_N2_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) simd=SIMD_AVX2;
+    if(simd==SIMD_AVX2 && __builtin_cpu_supports("avx512f")) simd=SIMD_AVX512;
+#endif
+    const char *env=getenv("SBTL_N2_SIMD");
+    if(env) {
+        if(strcmp(env, "scalar")==0) simd=SIMD_SCALAR;
+        else if(strcmp(env, "avx2")==0 && simd>SIMD_AVX2) simd=SIMD_AVX2;
+    }
+    return simd;
+}
+//
+void SPLINE_N2_N_SIMD(int simd, const SBTL_COEF_N2 *data, const int *offset, const double *dx1, const double *dx2, double *z, size_t n) throw()
+{
+#ifdef SPLINE_N2_X86
+    if(simd==SIMD_AVX512) {
+        SPLINE_N2_N_AVX512(data, offset, dx1, dx2, z, n);
+        return;
+    } else if(simd==SIMD_AVX2) {
+        SPLINE_N2_N_AVX2(data, offset, dx1, dx2, z, n);
+        return;
+    }
+#endif
+    SPLINE_N2_N_SCALAR(data, offset, dx1, dx2, z, n);
+}
+//
+SBTLAPI int __stdcall SIMD_LEVEL_N2() throw()
+{
+    static const int simd=SPLINE_N2_SELECT();
+    return simd;
+}
+//
+void SPLINE_N2_N(const SBTL_COEF_N2 *data, const int *offset, const double *dx1, const double *dx2, double *z, size_t n) throw()
+{
+    static const int simd=SIMD_LEVEL_N2();
+    SPLINE_N2_N_SIMD(simd, data, offset, dx1, dx2, z, n);
+}
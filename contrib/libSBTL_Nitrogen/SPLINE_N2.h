@@ -0,0 +1,47 @@
+///////////////////////////////////////////////////////////////////////////
+// LibSBTL_vu_N2 - SBTL library for gaseous nitrogen based on:
+//
+// Span, R., Lemmon, E.W., Jacobsen, R.T, Wagner, W., and Yokozeki, A.:
+//
+//   "A Reference Equation of State for the Thermodynamic Properties of Nitrogen for Temperatures
+//   from 63.151 to 1000 K and Pressures to 2200 MPa," J. Phys. Chem. Ref. Data, 29(6):1361-1433,
+//   2000.
+//
+// Lemmon, E.W. and Jacobsen, R.T.:
+//
+//   "Viscosity and Thermal Conductivity Equations for Nitrogen, Oxygen, Argon, and Air"
+//   Int. J. Thermophys., 25:21-69, 2004.
+//
+// Copyright (C) Idaho National Laboratory.
+// All rights reserved.
+//
+// Disclaimer:
+// The Idaho National Laboratory (INL) uses its best efforts to deliver a high-quality software and
+// to verify that the computed information is correct. However, INL makes no warranties to that
+// effect, and INL shall not be liable for any damage that may result from errors or omissions in
+// the software.
+//
+// Version: 0.9.0
+//
+// SPLINE_N2.h - vectorized evaluation of biquadratic spline cells
+//
+///////////////////////////////////////////////////////////////////////////
+//
+#pragma once
+//
+#include "stddef.h"
+#include "SBTL_TAB_N2.h"
+//
+// instruction sets of the cell kernel
+#define SIMD_SCALAR 0
+#define SIMD_AVX2 1
+#define SIMD_AVX512 2
+//
+// Evaluates the 9-coefficient cells data[offset[k]] at (dx1[k], dx2[k]) for k < n. The kernel is
+// selected at the first call from the instruction sets supported by the CPU; the environment
+// variable SBTL_N2_SIMD=scalar|avx2|avx512 limits the selection.
+void SPLINE_N2_N(const SBTL_COEF_N2 *data, const int *offset, const double *dx1, const double *dx2, double *z, size_t n) throw();
+//
+// kernel for a given instruction set, which must be supported by the CPU
+// (falls back to SIMD_SCALAR if it is not compiled in)
+void SPLINE_N2_N_SIMD(int simd, const SBTL_COEF_N2 *data, const int *offset, const double *dx1, const double *dx2, double *z, size_t n) throw();
@@ -43,60 +43,12 @@
 //         nodes: 75
 //       x2_max=1531.29
 //
-#include "math.h"
 #include "SBTL_call_conv.h"
-#include "SBTL_def.h"
-//
-extern const double x1_UVHN2[];
-extern const double x2_UVHN2[];
-//extern const double x1_RS_UVHN2[];
-//extern const double x2_RS_UVHN2[];
-extern const double data_UVHN2[];
+#include "U_VH_N2_INI.h"
 //
 SBTLAPI double __stdcall U_VH_N2_INI_T(double vt, double h) throw()
 {
-    unsigned int i=0, j=0;
-    double x1f, x2f;
-    double dx1, dx2;
-    static const double x1_sub_RS_0=-6.4666808844032;
-    static const double x1_sub_RS_1=-4.6239733243559;
-    static const double ZS_1=-4.5291313049285;
-    static const double dist_x1_inv_0=26.591305675623;
-    static const double dist_x1_inv_1=6.5755833467369;
-    static const double x2_sub_RS_0=191.05312162162;
-    static const double dist_x2_inv_0=5.558718850517e-002;
-//
-// transformations
-//  x1t=log(v);
-//
-    if(vt>ZS_1) {
-        x1f=(vt-ZS_1)*dist_x1_inv_1;
-        i=IROUND(x1f)+50;
-        if(i>123) i=123;
-    } else if(vt<x1_sub_RS_1) {
-        x1f=(vt-x1_sub_RS_0)*dist_x1_inv_0;
-        if(x1f>0.) i=IROUND(x1f);
-        else i=0;
-    } else {
-        i=49;
-    }
-//
-    x2f=(h-x2_sub_RS_0)*dist_x2_inv_0;
-    if(x2f>0.) {
-        j=IROUND(x2f);
-        if(j>74) j=74;
-    } else j=0;
-//
-    const double *val=&data_UVHN2[9*(j*124+i)];
-//
-    dx1=vt-x1_UVHN2[i];
-    dx2=h -x2_UVHN2[j];
-//
-    return val[0]
-        + dx2 * ( val[1] + dx2 *   val[2]  )
-        + dx1 * ( val[3] + dx2 * ( val[4] + dx2 *  val[5]  ) + dx1 * ( val[6]
-        + dx2 * ( val[7] + dx2 *   val[8]
-          ) ) );
+    return U_VH_N2_INI_T_INL(vt, h);
 }
 //
 const double x1_UVHN2[124] = {
@@ -153,6 +105,9 @@ const double x2_RS_UVHN2[76] = {
     1450.3360945946,1468.3258513514,1486.3156081081,1504.3053648649,1522.2951216216,1540.2848783784
 };
 */
+#ifndef SBTL_NO_EMBEDDED_TABLES
+// external linkage: referenced by the table registry (SBTL_TAB_N2.cpp)
+extern const double data_UVHN2[];
 const double data_UVHN2[83700] = {
     58.942967107254,0.46190678607262,-9.8540322922905e-006,187.58560420808,0.27387364480831,1.3757934920336e-005,37.969413437529,1.8522008175492e-002,-1.7945124717915e-006,65.943665689329,
     0.4721799597323,-9.3341097273138e-006,179.01827459275,0.26969438221743,1.4162844516437e-005,-265.7858940627,-0.12965405722831,1.2561587312674e-005,72.326304142378,0.48214701916959,
@@ -8525,4 +8480,5 @@ const double data_UVHN2[83700] = {
     -1.9062402249663e-007,-3.1381061134746e-012,1121.8870641937,0.75848938956653,-1.7751209982486e-006,5.3638153261092e-004,3.3365756024625e-007,5.471466763723e-012,-3.178447395e-004,-1.97718157879e-007,
     -3.2306665917467e-012,1121.8871405147,0.75848943704217,-1.7751202195312e-006,4.949497183099e-004,3.0788453028404e-007,5.0503433863248e-012,4.5406391357143e-005,2.8245451264563e-008,4.6153472440237e-013
 };
+#endif
 //
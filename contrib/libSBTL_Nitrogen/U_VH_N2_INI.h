@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////
+// LibSBTL_vu_N2 - SBTL library for gaseous nitrogen based on:
+//
+// Span, R., Lemmon, E.W., Jacobsen, R.T, Wagner, W., and Yokozeki, A.:
+//
+//   "A Reference Equation of State for the Thermodynamic Properties of Nitrogen for Temperatures
+//   from 63.151 to 1000 K and Pressures to 2200 MPa," J. Phys. Chem. Ref. Data, 29(6):1361-1433,
+//   2000.
+//
+// Lemmon, E.W. and Jacobsen, R.T.:
+//
+//   "Viscosity and Thermal Conductivity Equations for Nitrogen, Oxygen, Argon, and Air"
+//   Int. J. Thermophys., 25:21-69, 2004.
+//
+// Copyright (C) Idaho National Laboratory.
+// All rights reserved.
+//
+// Disclaimer:
+// The Idaho National Laboratory (INL) uses its best efforts to deliver a high-quality software and
+// to verify that the computed information is correct. However, INL makes no warranties to that
+// effect, and INL shall not be liable for any damage that may result from errors or omissions in
+// the software.
+//
+// Version: 0.9.0
+//
+// U_VH_N2_INI.h - cell search of the initial guess spline u(vt,h), written by sbtl_n2_gen
+//
+///////////////////////////////////////////////////////////////////////////
+//
+#pragma once
+//
+#include "SBTL_def.h"
+#include "SBTL_TAB_N2.h"
+//
+// number of cells in x1 (vt) and x2 (h)
+#define NX1_UVHN2 124
+#define NX2_UVHN2 75
+//
+extern const double x1_UVHN2[];
+extern const double x2_UVHN2[];
+//
+// initial guess u(vt,h)
+inline double
+U_VH_N2_INI_T_INL(double vt, double h) throw()
+{
+  unsigned int i, j;
+  double x1f, x2f;
+
+  static const double x1_sub_RS_0 = -6.4666808844032;
+  static const double x1_sub_RS_1 = -4.6239733243559;
+  static const double ZS_1 = -4.5291313049285;
+  static const double dist_x1_inv_0 = 26.591305675623;
+  static const double dist_x1_inv_1 = 6.5755833467369;
+  static const double x2_sub_RS_0 = 191.05312162162;
+  static const double dist_x2_inv_0 = 0.05558718850517;
+
+  if (vt > ZS_1)
+  {
+    x1f = (vt - ZS_1) * dist_x1_inv_1;
+    i = IROUND(x1f) + 50;
+    if (i > NX1_UVHN2 - 1)
+      i = NX1_UVHN2 - 1;
+  }
+  else if (vt < x1_sub_RS_1)
+  {
+    x1f = (vt - x1_sub_RS_0) * dist_x1_inv_0;
+    if (x1f > 0.)
+      i = IROUND(x1f);
+    else
+      i = 0;
+  }
+  else
+  {
+    i = 49;
+  }
+
+  x2f = (h - x2_sub_RS_0) * dist_x2_inv_0;
+  if (x2f > 0.)
+  {
+    j = IROUND(x2f);
+    if (j > NX2_UVHN2 - 1)
+      j = NX2_UVHN2 - 1;
+  }
+  else
+    j = 0;
+
+  const SBTL_COEF_N2 * val = &SBTL_TAB_N2[ITAB_UVHN2][9 * (j * NX1_UVHN2 + i)];
+  const double dx1 = vt - x1_UVHN2[i];
+  const double dx2 = h - x2_UVHN2[j];
+
+  return val[0] + dx2 * (val[1] + dx2 * val[2]) +
+         dx1 * (val[3] + dx2 * (val[4] + dx2 * val[5]) +
+                dx1 * (val[6] + dx2 * (val[7] + dx2 * val[8])));
+}
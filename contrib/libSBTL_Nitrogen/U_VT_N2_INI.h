@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////
+// LibSBTL_vu_N2 - SBTL library for gaseous nitrogen based on:
+//
+// Span, R., Lemmon, E.W., Jacobsen, R.T, Wagner, W., and Yokozeki, A.:
+//
+//   "A Reference Equation of State for the Thermodynamic Properties of Nitrogen for Temperatures
+//   from 63.151 to 1000 K and Pressures to 2200 MPa," J. Phys. Chem. Ref. Data, 29(6):1361-1433,
+//   2000.
+//
+// Lemmon, E.W. and Jacobsen, R.T.:
+//
+//   "Viscosity and Thermal Conductivity Equations for Nitrogen, Oxygen, Argon, and Air"
+//   Int. J. Thermophys., 25:21-69, 2004.
+//
+// Copyright (C) Idaho National Laboratory.
+// All rights reserved.
+//
+// Disclaimer:
+// The Idaho National Laboratory (INL) uses its best efforts to deliver a high-quality software and
+// to verify that the computed information is correct. However, INL makes no warranties to that
+// effect, and INL shall not be liable for any damage that may result from errors or omissions in
+// the software.
+//
+// Version: 0.9.0
+//
+// U_VT_N2_INI.h - cell search of the initial guess spline u(vt,t), written by sbtl_n2_gen
+//
+///////////////////////////////////////////////////////////////////////////
+//
+#pragma once
+//
+#include "SBTL_def.h"
+#include "SBTL_TAB_N2.h"
+//
+// number of cells in x1 (vt) and x2 (t)
+#define NX1_UVTN2I 200
+#define NX2_UVTN2I 100
+//
+extern const double x1_UVTN2I[];
+extern const double x2_UVTN2I[];
+//
+// initial guess u(vt,t)
+inline double
+U_VT_N2_INI_T_INL(double vt, double t) throw()
+{
+  unsigned int i, j;
+  double x1f, x2f;
+
+  static const double x1_sub_RS_0 = -6.4807897588371;
+  static const double dist_x1_inv_0 = 15.194936214085;
+  static const double x2_sub_RS_0 = 244.69696969697;
+  static const double dist_x2_inv_0 = 0.094285714285714;
+
+  x1f = (vt - x1_sub_RS_0) * dist_x1_inv_0;
+  if (x1f > 0.)
+  {
+    i = IROUND(x1f);
+    if (i > NX1_UVTN2I - 1)
+      i = NX1_UVTN2I - 1;
+  }
+  else
+    i = 0;
+
+  x2f = (t - x2_sub_RS_0) * dist_x2_inv_0;
+  if (x2f > 0.)
+  {
+    j = IROUND(x2f);
+    if (j > NX2_UVTN2I - 1)
+      j = NX2_UVTN2I - 1;
+  }
+  else
+    j = 0;
+
+  const SBTL_COEF_N2 * val = &SBTL_TAB_N2[ITAB_UVTN2I][9 * (j * NX1_UVTN2I + i)];
+  const double dx1 = vt - x1_UVTN2I[i];
+  const double dx2 = t - x2_UVTN2I[j];
+
+  return val[0] + dx2 * (val[1] + dx2 * val[2]) +
+         dx1 * (val[3] + dx2 * (val[4] + dx2 * val[5]) +
+                dx1 * (val[6] + dx2 * (val[7] + dx2 * val[8])));
+}
@@ -25,80 +25,16 @@
 #include "math.h"
 #include "SBTL_call_conv.h"
 #include "SBTL_def.h"
-//
-extern const double x1_VUN2[];
-extern const double x2_VUN2[];
-extern const double x2_RS_VUN2[];
+#include "VU_N2.h"
 //
 void IJ_VU_N2(double v, double u, unsigned int& i, unsigned int& j, double& dx1, double& dx2) throw()
 {
-    double x1t,x1f,x2f;
-
-    static const double x1_sub_RS_0=-6.457330306892;
-    static const double x1_sub_RS_1=-4.6144775232791;
-    static const double ZS_1=-4.576894421172;
-    static const double dist_x1_inv_0=53.721057308717;
-    static const double dist_x1_inv_1=17.682987648657;
-    static const double x2_sub_RS_0=71.314715577889;
-    static const double dist_x2_inv_0=0.20420795635245;
-//
-// transformations
-    x1t=log(v);
-//
-    if(x1t>ZS_1) {
-        x1f=(x1t-ZS_1)*dist_x1_inv_1;
-        i=IROUND(x1f)+100;
-        if(i>298) i=298;
-    } else if(x1t<x1_sub_RS_1) {
-        x1f=(x1t-x1_sub_RS_0)*dist_x1_inv_0;
-        if(x1f>0.) i=IROUND(x1f);
-        else i=0;
-    } else {
-        i=99;
-    }
-//
-    x2f=(u-x2_sub_RS_0)*dist_x2_inv_0;
-    if(x2f>0.) {
-        j=IROUND(x2f);
-        if(j>199) j=199;
-    } else j=0;
-//
-    dx1=x1t-x1_VUN2[i];
-    dx2=u-x2_VUN2[j];
+    IJ_VU_N2_T_INL(log(v), u, i, j, dx1, dx2);
 }
 //
 void IJ_VU_N2_T(double vt, double u, unsigned int& i, unsigned int& j, double& dx1, double& dx2) throw()
 {
-    double x1f,x2f;
-
-    static const double x1_sub_RS_0=-6.457330306892;
-    static const double x1_sub_RS_1=-4.6144775232791;
-    static const double ZS_1=-4.576894421172;
-    static const double dist_x1_inv_0=53.721057308717;
-    static const double dist_x1_inv_1=17.682987648657;
-    static const double x2_sub_RS_0=71.314715577889;
-    static const double dist_x2_inv_0=0.20420795635245;
-//
-    if(vt>ZS_1) {
-        x1f=(vt-ZS_1)*dist_x1_inv_1;
-        i=IROUND(x1f)+100;
-        if(i>298) i=298;
-    } else if(vt<x1_sub_RS_1) {
-        x1f=(vt-x1_sub_RS_0)*dist_x1_inv_0;
-        if(x1f>0.) i=IROUND(x1f);
-        else i=0;
-    } else {
-        i=99;
-    }
-//
-    x2f=(u-x2_sub_RS_0)*dist_x2_inv_0;
-    if(x2f>0.) {
-        j=IROUND(x2f);
-        if(j>199) j=199;
-    } else j=0;
-//
-    dx1=vt-x1_VUN2[i];
-    dx2=u-x2_VUN2[j];
+    IJ_VU_N2_T_INL(vt, u, i, j, dx1, dx2);
 }
 //
 const double x1_VUN2[299] = {
@@ -133,7 +69,6 @@ const double x1_VUN2[299] = {
     5.6306566774516,5.6872082070839,5.7437597367162,5.8003112663484,5.8568627959807,5.913414325613,5.9699658552452,6.0265173848775,6.0830689145097,6.139620444142,
     6.1961719737743,6.2527235034065,6.3092750330388,6.3658265626711,6.4223780923033,6.4789296219356,6.5354811515678,6.5920326812001,6.6485842108324
 };
-/*
 const double x1_RS_VUN2[300] = {
     -6.457330306892,-6.4387156323101,-6.4201009577281,-6.4014862831462,-6.3828716085642,-6.3642569339823,-6.3456422594003,-6.3270275848184,-6.3084129102364,-6.2897982356545,
     -6.2711835610725,-6.2525688864906,-6.2339542119086,-6.2153395373267,-6.1967248627447,-6.1781101881628,-6.1594955135808,-6.1408808389989,-6.1222661644169,-6.103651489835,
@@ -166,7 +101,6 @@ const double x1_RS_VUN2[300] = {
     5.6023809126355,5.6589324422678,5.7154839719,5.7720355015323,5.8285870311646,5.8851385607968,5.9416900904291,5.9982416200613,6.0547931496936,6.1113446793259,
     6.1678962089581,6.2244477385904,6.2809992682227,6.3375507978549,6.3941023274872,6.4506538571195,6.5072053867517,6.563756916384,6.6203084460162,6.6768599756485
 };
-*/
 const double x2_VUN2[200] = {
     73.7632,78.660168844221,83.557137688442,88.454106532663,93.351075376884,98.248044221106,103.14501306533,108.04198190955,112.93895075377,117.83591959799,
     122.73288844221,127.62985728643,132.52682613065,137.42379497487,142.3207638191,147.21773266332,152.11470150754,157.01167035176,161.90863919598,166.8056080402,
@@ -0,0 +1,198 @@
+///////////////////////////////////////////////////////////////////////////
+// LibSBTL_vu_N2 - SBTL library for gaseous nitrogen based on:
+//
+// Span, R., Lemmon, E.W., Jacobsen, R.T, Wagner, W., and Yokozeki, A.:
+//
+//   "A Reference Equation of State for the Thermodynamic Properties of Nitrogen for Temperatures
+//   from 63.151 to 1000 K and Pressures to 2200 MPa," J. Phys. Chem. Ref. Data, 29(6):1361-1433,
+//   2000.
+//
+// Lemmon, E.W. and Jacobsen, R.T.:
+//
+//   "Viscosity and Thermal Conductivity Equations for Nitrogen, Oxygen, Argon, and Air"
+//   Int. J. Thermophys., 25:21-69, 2004.
+//
+// Copyright (C) Idaho National Laboratory.
+// All rights reserved.
+//
+// Disclaimer:
+// The Idaho National Laboratory (INL) uses its best efforts to deliver a high-quality software and
+// to verify that the computed information is correct. However, INL makes no warranties to that
+// effect, and INL shall not be liable for any damage that may result from errors or omissions in
+// the software.
+//
+// Version: 0.9.0
+//
+// VU_N2.h - forward spline grid (vt=log(v), u) shared by all *_VU_N2 functions
+//
+///////////////////////////////////////////////////////////////////////////
+//
+#pragma once
+//
+#include "math.h"
+#include "SBTL_def.h"
+#include "SBTL_TAB_N2.h"
+//
+// number of cells in x1 (vt) and x2 (u)
+#define NX1_VUN2 299
+#define NX2_VUN2 200
+//
+// forward spline grid
+extern const double x1_VUN2[];
+extern const double x2_VUN2[];
+extern const double x1_RS_VUN2[];
+extern const double x2_RS_VUN2[];
+//
+// forward spline data (9 coefficients per cell): SBTL_TAB_N2[ITAB_*VUN2]
+//
+// cell indices and distances to the cell nodes for a transformed volume vt
+inline void
+IJ_VU_N2_T_INL(
+    double vt, double u, unsigned int & i, unsigned int & j, double & dx1, double & dx2) throw()
+{
+  double x1f, x2f;
+
+  static const double x1_sub_RS_0 = -6.457330306892;
+  static const double x1_sub_RS_1 = -4.6144775232791;
+  static const double ZS_1 = -4.576894421172;
+  static const double dist_x1_inv_0 = 53.721057308717;
+  static const double dist_x1_inv_1 = 17.682987648657;
+  static const double x2_sub_RS_0 = 71.314715577889;
+  static const double dist_x2_inv_0 = 0.20420795635245;
+
+  if (vt > ZS_1)
+  {
+    x1f = (vt - ZS_1) * dist_x1_inv_1;
+    i = IROUND(x1f) + 100;
+    if (i > NX1_VUN2 - 1)
+      i = NX1_VUN2 - 1;
+  }
+  else if (vt < x1_sub_RS_1)
+  {
+    x1f = (vt - x1_sub_RS_0) * dist_x1_inv_0;
+    if (x1f > 0.)
+      i = IROUND(x1f);
+    else
+      i = 0;
+  }
+  else
+  {
+    i = 99;
+  }
+
+  x2f = (u - x2_sub_RS_0) * dist_x2_inv_0;
+  if (x2f > 0.)
+  {
+    j = IROUND(x2f);
+    if (j > NX2_VUN2 - 1)
+      j = NX2_VUN2 - 1;
+  }
+  else
+    j = 0;
+
+  dx1 = vt - x1_VUN2[i];
+  dx2 = u - x2_VUN2[j];
+}
+//
+// as IJ_VU_N2_T_INL, but keeps the cell of the hint 'cell' if it contains (vt,u), see CELL_NONE_N2
+// in SBTL_N2.h; 'cell' returns the cell
+inline void
+IJ_VU_N2_T_HINT_INL(double vt,
+                    double u,
+                    unsigned int & cell,
+                    unsigned int & i,
+                    unsigned int & j,
+                    double & dx1,
+                    double & dx2) throw()
+{
+  i = cell & 0xFFFF;
+  j = cell >> 16;
+  if (i < NX1_VUN2 && j < NX2_VUN2 && vt >= x1_RS_VUN2[i] && vt < x1_RS_VUN2[i + 1] &&
+      u >= x2_RS_VUN2[j] && u < x2_RS_VUN2[j + 1])
+  {
+    dx1 = vt - x1_VUN2[i];
+    dx2 = u - x2_VUN2[j];
+  }
+  else
+  {
+    IJ_VU_N2_T_INL(vt, u, i, j, dx1, dx2);
+    cell = (j << 16) | i;
+  }
+}
+//
+// number of cells of the forward spline data in tiles of 'tile' x 'tile' cells, including the
+// padding of the last column and row of tiles
+#define NCELL_TILE_VUN2(tile)                                                                     \
+  (((NX1_VUN2 + (tile)-1) / (tile)) * ((NX2_VUN2 + (tile)-1) / (tile)) * (tile) * (tile))
+#define NCELL_VUN2 NCELL_TILE_VUN2(SBTL_TILE_N2)
+//
+// offset of the coefficients of cell (i,j) in forward spline data with tiles of 'tile' x 'tile'
+// cells: the tiles are stored row-major, and the cells of each tile row-major (tile 1: row-major)
+inline unsigned int
+OFFSET_TILE_VU_N2(unsigned int i, unsigned int j, unsigned int tile) throw()
+{
+  const unsigned int nt1 = (NX1_VUN2 + tile - 1) / tile;
+  return 9 * (((j / tile) * nt1 + i / tile) * tile * tile + (j % tile) * tile + i % tile);
+}
+//
+// offset of the coefficients of cell (i,j) in the forward spline data (cell layout of the library)
+inline unsigned int
+OFFSET_VU_N2(unsigned int i, unsigned int j) throw()
+{
+  return OFFSET_TILE_VU_N2(i, j, SBTL_TILE_N2);
+}
+//
+// coefficients of cell (i,j) (of SBTL_TAB_N2 or of the double precision SBTL_TAB_N2_DOUBLE)
+template <typename COEF>
+inline const COEF *
+CELL_VU_N2(const COEF * data, unsigned int i, unsigned int j) throw()
+{
+  return &data[OFFSET_VU_N2(i, j)];
+}
+//
+// biquadratic polynomial of a single cell, evaluated in double precision
+template <typename COEF>
+inline double
+SPLINE_VU_N2(const COEF * val, double dx1, double dx2) throw()
+{
+  return val[0] + dx2 * (val[1] + dx2 * val[2]) +
+         dx1 * (val[3] + dx2 * (val[4] + dx2 * val[5]) +
+                dx1 * (val[6] + dx2 * (val[7] + dx2 * val[8])));
+}
+//
+// biquadratic polynomial of a single cell and its derivatives w.r.t. dx1 and dx2
+template <typename COEF>
+inline void
+DIFF_SPLINE_VU_N2(
+    const COEF * val, double dx1, double dx2, double & z, double & dzdx1, double & dzdx2) throw()
+{
+  const double c0 = val[0] + dx2 * (val[1] + dx2 * val[2]);
+  const double c1 = val[3] + dx2 * (val[4] + dx2 * val[5]);
+  const double c2 = val[6] + dx2 * (val[7] + dx2 * val[8]);
+  z = c0 + dx1 * (c1 + dx1 * c2);
+  dzdx1 = c1 + 2. * dx1 * c2;
+  dzdx2 = val[1] + 2. * dx2 * val[2] + dx1 * (val[4] + 2. * dx2 * val[5] +
+                                              dx1 * (val[7] + 2. * dx2 * val[8]));
+}
+//
+// forward spline 'data' and its derivatives w.r.t. v and u, and (du/dv)_z
+inline void
+DIFF_VU_N2_T_INL(const SBTL_COEF_N2 * data,
+                 double vt,
+                 double v,
+                 double u,
+                 double & z,
+                 double & dzdv,
+                 double & dzdu,
+                 double & dudv) throw()
+{
+  unsigned int i, j;
+  double dx1, dx2, dzdx1;
+
+  IJ_VU_N2_T_INL(vt, u, i, j, dx1, dx2);
+  DIFF_SPLINE_VU_N2(CELL_VU_N2(data, i, j), dx1, dx2, z, dzdx1, dzdu);
+  // consider transformations
+  dzdv = dzdx1 / v;
+  // calculate remaining differential
+  dudv = -dzdv / dzdu;
+}
@@ -0,0 +1,231 @@
+///////////////////////////////////////////////////////////////////////////
+// LibSBTL_vu_N2 - SBTL library for gaseous nitrogen based on:
+//
+// Span, R., Lemmon, E.W., Jacobsen, R.T, Wagner, W., and Yokozeki, A.:
+//
+//   "A Reference Equation of State for the Thermodynamic Properties of Nitrogen for Temperatures
+//   from 63.151 to 1000 K and Pressures to 2200 MPa," J. Phys. Chem. Ref. Data, 29(6):1361-1433,
+//   2000.
+//
+// Lemmon, E.W. and Jacobsen, R.T.:
+//
+//   "Viscosity and Thermal Conductivity Equations for Nitrogen, Oxygen, Argon, and Air"
+//   Int. J. Thermophys., 25:21-69, 2004.
+//
+// Copyright (C) Idaho National Laboratory.
+// All rights reserved.
+//
+// Disclaimer:
+// The Idaho National Laboratory (INL) uses its best efforts to deliver a high-quality software and
+// to verify that the computed information is correct. However, INL makes no warranties to that
+// effect, and INL shall not be liable for any damage that may result from errors or omissions in
+// the software.
+//
+// Version: 0.9.0
+//
+// VU_N2_N - forward functions for arrays of state points
+//
+///////////////////////////////////////////////////////////////////////////
+//
+#include "math.h"
+#include "stddef.h"
+#include "stdint.h"
+#include "stdlib.h"
+#include "SBTL_call_conv.h"
+#include "SBTL_N2.h"
+#include "SPLINE_N2.h"
+#include "VU_N2.h"
+//
+// number of state points per call of the cell kernel
+#define NCHUNK 256
+//
+// cells of n <= NCHUNK state points (v[k], u[k])
+static inline void OFFSET_VU_N2_N(const double *v, const double *u, int *offset, double *dx1, double *dx2, size_t n) throw()
+{
+    unsigned int i, j;
+//
+    for(size_t k=0; k<n; k++) {
+        IJ_VU_N2_T_INL(log(v[k]), u[k], i, j, dx1[k], dx2[k]);
+        offset[k]=OFFSET_VU_N2(i, j);
+    }
+}
+//
+// evaluate the forward spline 'data' for n state points (v[k], u[k])
+static void SPLINE_VU_N2_N(const SBTL_COEF_N2 *data, const double *v, const double *u, double *z, size_t n) throw()
+{
+    int offset[NCHUNK];
+    double dx1[NCHUNK], dx2[NCHUNK];
+//
+    for(size_t k0=0; k0<n; k0+=NCHUNK) {
+        const size_t m=n-k0<NCHUNK ? n-k0 : NCHUNK;
+        OFFSET_VU_N2_N(v+k0, u+k0, offset, dx1, dx2, m);
+        SPLINE_N2_N(data, offset, dx1, dx2, z+k0, m);
+    }
+}
+//
+SBTLAPI void __stdcall P_VU_N2_N(const double *v, const double *u, double *p, size_t n) throw()
+{
+    SPLINE_VU_N2_N(SBTL_TAB_N2[ITAB_PVUN2], v, u, p, n);
+}
+//
+SBTLAPI void __stdcall T_VU_N2_N(const double *v, const double *u, double *t, size_t n) throw()
+{
+    SPLINE_VU_N2_N(SBTL_TAB_N2[ITAB_TVUN2], v, u, t, n);
+}
+//
+SBTLAPI void __stdcall S_VU_N2_N(const double *v, const double *u, double *s, size_t n) throw()
+{
+    SPLINE_VU_N2_N(SBTL_TAB_N2[ITAB_SVUN2], v, u, s, n);
+}
+//
+SBTLAPI void __stdcall W_VU_N2_N(const double *v, const double *u, double *w, size_t n) throw()
+{
+    SPLINE_VU_N2_N(SBTL_TAB_N2[ITAB_WVUN2], v, u, w, n);
+}
+//
+SBTLAPI void __stdcall CP_VU_N2_N(const double *v, const double *u, double *cp, size_t n) throw()
+{
+    SPLINE_VU_N2_N(SBTL_TAB_N2[ITAB_CPVUN2], v, u, cp, n);
+}
+//
+SBTLAPI void __stdcall CV_VU_N2_N(const double *v, const double *u, double *cv, size_t n) throw()
+{
+    SPLINE_VU_N2_N(SBTL_TAB_N2[ITAB_CVVUN2], v, u, cv, n);
+}
+//
+SBTLAPI void __stdcall ETA_VU_N2_N(const double *v, const double *u, double *eta, size_t n) throw()
+{
+    SPLINE_VU_N2_N(SBTL_TAB_N2[ITAB_ETAVUN2], v, u, eta, n);
+}
+//
+SBTLAPI void __stdcall LAMBDA_VU_N2_N(const double *v, const double *u, double *lambda, size_t n) throw()
+{
+    SPLINE_VU_N2_N(SBTL_TAB_N2[ITAB_LAMBDAVUN2], v, u, lambda, n);
+}
+//
+// g=h-t*s with h=u+p*v*1.e3 from the splines p, t and s, which share the cells of each chunk
+SBTLAPI void __stdcall G_VU_N2_N(const double *v, const double *u, double *g, size_t n) throw()
+{
+    int offset[NCHUNK];
+    double dx1[NCHUNK], dx2[NCHUNK], p[NCHUNK], t[NCHUNK], s[NCHUNK];
+//
+    for(size_t k0=0; k0<n; k0+=NCHUNK) {
+        const size_t m=n-k0<NCHUNK ? n-k0 : NCHUNK;
+        OFFSET_VU_N2_N(v+k0, u+k0, offset, dx1, dx2, m);
+        SPLINE_N2_N(SBTL_TAB_N2[ITAB_PVUN2], offset, dx1, dx2, p, m);
+        SPLINE_N2_N(SBTL_TAB_N2[ITAB_TVUN2], offset, dx1, dx2, t, m);
+        SPLINE_N2_N(SBTL_TAB_N2[ITAB_SVUN2], offset, dx1, dx2, s, m);
+        for(size_t k=0; k<m; k++)
+            g[k0+k]=u[k0+k]+p[k]*v[k0+k]*1.e3-t[k]*s[k];
+    }
+}
+//
+//-----------------------------------------------------------------------------
+// cell-binned evaluation
+//-----------------------------------------------------------------------------
+//
+// forward spline tables in the order of the IALL_* indices
+static const int itab_NB_VUN2[NALL_VU_N2]={ITAB_PVUN2, ITAB_TVUN2, ITAB_SVUN2, ITAB_WVUN2,
+    ITAB_CPVUN2, ITAB_CVVUN2, ITAB_ETAVUN2, ITAB_LAMBDAVUN2};
+//
+// the state points sorted by cell: cell[m] (the cell index OFFSET_VU_N2 / 9, i.e. in memory
+// order), the point idx[m] and its dx1[m] and dx2[m]
+struct BINS_VU_N2 {
+    uint32_t *cell;
+    uint32_t *idx;
+    double *dx1;
+    double *dx2;
+};
+//
+// number of uint32_t of the workspace of BIN_VU_N2 after the bins: the cell of each point and the
+// counts per cell
+#define NWORK32_VUN2(n) (NCELL_VUN2+1+(n))
+//
+// bins n state points by a counting sort over the cells, in the workspace 'work' of 4 n doubles
+// and 2 n + NWORK32_VUN2(n) uint32_t (see VU_N2_NB_WORK)
+static void BIN_VU_N2(const double *v, const double *u, size_t n, double *work, BINS_VU_N2& bins) throw()
+{
+    unsigned int i, j;
+//
+    bins.dx1=work;
+    bins.dx2=bins.dx1+n;
+    double *dx1=bins.dx2+n;
+    double *dx2=dx1+n;
+    bins.cell=(uint32_t *)(dx2+n);
+    bins.idx=bins.cell+n;
+    uint32_t *cell=bins.idx+n;
+    uint32_t *start=cell+n;
+//
+// the cell of each point first, with the counts per cell shifted by one for the prefix sum
+    for(size_t c=0; c<=NCELL_VUN2; c++)
+        start[c]=0;
+    for(size_t k=0; k<n; k++) {
+        IJ_VU_N2_T_INL(log(v[k]), u[k], i, j, dx1[k], dx2[k]);
+        cell[k]=OFFSET_VU_N2(i, j)/9;
+        start[cell[k]+1]++;
+    }
+    for(size_t c=0; c<NCELL_VUN2; c++)
+        start[c+1]+=start[c];
+//
+// stable scatter into the bins
+    for(size_t k=0; k<n; k++) {
+        const uint32_t m=start[cell[k]]++;
+        bins.cell[m]=cell[k];
+        bins.idx[m]=(uint32_t)k;
+        bins.dx1[m]=dx1[k];
+        bins.dx2[m]=dx2[k];
+    }
+}
+//
+// evaluates the forward spline 'data' for the binned state points, one cell at a time with its
+// coefficients in registers, and scatters the results to z
+static void SPLINE_VU_N2_NB(const SBTL_COEF_N2 *data, const BINS_VU_N2& bins, double *z, size_t n) throw()
+{
+    for(size_t m0=0; m0<n;) {
+        const SBTL_COEF_N2 *val=&data[9*(size_t)bins.cell[m0]];
+        const double c0=val[0], c1=val[1], c2=val[2], c3=val[3], c4=val[4], c5=val[5],
+            c6=val[6], c7=val[7], c8=val[8];
+        size_t m=m0;
+        do {
+            const double dx1=bins.dx1[m], dx2=bins.dx2[m];
+            z[bins.idx[m]]=c0+dx2*(c1+dx2*c2)+dx1*(c3+dx2*(c4+dx2*c5)+dx1*(c6+dx2*(c7+dx2*c8)));
+            m++;
+        } while(m<n && bins.cell[m]==bins.cell[m0]);
+        m0=m;
+    }
+}
+//
+// number of doubles of the workspace of VU_N2_NB for n state points
+SBTLAPI size_t __stdcall VU_N2_NB_WORK(size_t n) throw()
+{
+    return 4*n+(2*n+NWORK32_VUN2(n)+1)/2;
+}
+//
+// the properties iall[l] = IALL_* in z[l][k] for n state points (v[k], u[k]), l < nprop: the
+// points are sorted by cell once, so that each cell's coefficients are loaded once per property
+// however the points are ordered. The sort costs O(n + number of cells) and about as much as one
+// property of P_VU_N2_N etc., so it pays off for several properties of large arrays only. The sort
+// needs VU_N2_NB_WORK(n) doubles of workspace: 'work' of the caller (e.g. kept between calls), or
+// allocated here if work is NULL. Returns I_ERR for an invalid property index
+SBTLAPI int __stdcall VU_N2_NB(int nprop, const int *iall, const double *v, const double *u, double *const *z, size_t n, double *work) throw()
+{
+    for(int l=0; l<nprop; l++)
+        if(iall[l]<0 || iall[l]>=NALL_VU_N2) return I_ERR;
+    if(nprop<=0 || n==0) return nprop<0 ? I_ERR : I_OK;
+//
+// the points of all properties are binned once
+    double *buf=NULL;
+    if(!work && n<=UINT32_MAX) work=buf=(double *)malloc(VU_N2_NB_WORK(n)*sizeof(double));
+    if(work && n<=UINT32_MAX) {
+        BINS_VU_N2 bins;
+        BIN_VU_N2(v, u, n, work, bins);
+        for(int l=0; l<nprop; l++)
+            SPLINE_VU_N2_NB(SBTL_TAB_N2[itab_NB_VUN2[iall[l]]], bins, z[l], n);
+    } else {
+// out of memory or more than UINT32_MAX points: point by point
+        for(int l=0; l<nprop; l++)
+            SPLINE_VU_N2_N(SBTL_TAB_N2[itab_NB_VUN2[iall[l]]], v, u, z[l], n);
+    }
+    free(buf);
+    return I_OK;
+}
@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////
+// LibSBTL_vu_N2 - SBTL library for gaseous nitrogen based on:
+//
+// Span, R., Lemmon, E.W., Jacobsen, R.T, Wagner, W., and Yokozeki, A.:
+//
+//   "A Reference Equation of State for the Thermodynamic Properties of Nitrogen for Temperatures
+//   from 63.151 to 1000 K and Pressures to 2200 MPa," J. Phys. Chem. Ref. Data, 29(6):1361-1433,
+//   2000.
+//
+// Lemmon, E.W. and Jacobsen, R.T.:
+//
+//   "Viscosity and Thermal Conductivity Equations for Nitrogen, Oxygen, Argon, and Air"
+//   Int. J. Thermophys., 25:21-69, 2004.
+//
+// Copyright (C) Idaho National Laboratory.
+// All rights reserved.
+//
+// Disclaimer:
+// The Idaho National Laboratory (INL) uses its best efforts to deliver a high-quality software and
+// to verify that the computed information is correct. However, INL makes no warranties to that
+// effect, and INL shall not be liable for any damage that may result from errors or omissions in
+// the software.
+//
+// Version: 0.9.0
+//
+// VU_PZ_N2 - backward splines vt(p,z) and u(p,z) for z = t, h and s
+//
+///////////////////////////////////////////////////////////////////////////
+//
+// The backward splines are C1 continuous biquadratic splines in x1 = ln(p) and the normalized
+// second variable x2 = (z - zmin(p)) / (zmax(p) - zmin(p)), where zmin and zmax are z at TMIN_N2
+// and TMAX_N2 (quadratic splines in ln(p) for h and s), with the knots halfway between equidistant
+// nodes. They interpolate the inverse of the forward splines at the nodes and are generated with
+// them by sbtl_n2_gen (VU_PZ_N2_TAB.h/.cpp, tables ITAB_VUPTN2, ITAB_VUPHN2 and ITAB_VUPSN2 of a
+// table file), so they are not fitted at run time.
+//
+// Each cell also keeps bounds of the residuals |p(vt,u) - p| / p and |z(vt,u) - z| at the backward
+// result: twice the largest residual of the forward splines and of the reference equations on a
+// grid of 1/8 of the cell. With TOL_BACKWARD_N2, the flashes skip Newton's method in the cells
+// whose bounds meet the criteria, which all cells of the generated tables do.
+//
+#include "math.h"
+#include "SBTL_N2.h"
+#include "SBTL_call_conv.h"
+#include "SBTL_def.h"
+#include "SBTL_TAB_N2.h"
+#include "VU_N2.h"
+#include "VU_PZ_N2_TAB.h"
+//
+// slack of the grid bounds in units of the node spacing: zmin(x1) and zmax(x1) deviate from z at
+// TMIN_N2 and TMAX_N2 by up to about 5e-6 in x2
+#define DX_EDGE_VUPZN2 1.e-3
+//
+#ifdef SBTL_FLOAT_TABLES
+// rounding of the float coefficients of the forward and backward splines, added to the residual
+// bounds of the cells, which are generated for double coefficients: relative in p, absolute in t,
+// h and s (about five times the excess over the bounds found by sbtl_n2_validate)
+static const double DF_FLOAT_VUPZN2[4]={1.e-6, 5.e-4, 1.e-3, 5.e-6};
+#endif
+//
+// nearest node k of x in 0..n-1 for the node spacing 1/h_inv; false if x is outside the grid
+static inline bool
+NODE_VUPZN2(double x, double h_inv, unsigned int n, unsigned int& k) throw()
+{
+    const double xf=x*h_inv;
+    if(!(xf>=-DX_EDGE_VUPZN2 && xf<=n-1+DX_EDGE_VUPZN2)) return false;
+    const double xk=xf+0.5;
+    k=xk<=0. ? 0 : IROUND(xk);
+    if(k>n-1) k=n-1;
+    return true;
+}
+//
+// node i in x1 with the offset dx1 and the normalized x2 of (p,z) for the backward splines 'itab'
+// (see VU_PZ_N2_INL); false if (p,z) is outside the grid
+static inline bool
+X_PZ_N2_INL(const SBTL_COEF_N2 *data, int itab, double p, double z, unsigned int& i, double& dx1, double& x2) throw()
+{
+    const double h1=(X1_MAX_VUPZN2-X1_MIN_VUPZN2)/(NX1_VUPZN2-1);
+    const double x1=log(p)-X1_MIN_VUPZN2;
+    if(!NODE_VUPZN2(x1, 1./h1, NX1_VUPZN2, i)) return false;
+    dx1=x1-i*h1;
+    const SBTL_COEF_N2 *b=&data[NCOEF_VUPZN2*NCELL_VUPZN2+NBOUND_VUPZN2*i];
+    x2=itab==ITAB_VUPTN2 ? (z-TMIN_N2)*(1./(TMAX_N2-TMIN_N2))
+                         : (z-(b[0]+dx1*(b[1]+dx1*b[2])))*(b[3]+dx1*(b[4]+dx1*b[5]));
+    return true;
+}
+//
+// vt and u at (p,z) from the backward splines 'itab' with the residual bounds df_p and df_z of the
+// cell; I_ERR if the table is not available or (p,z) is outside the grid, i.e. the range of
+// validity, where the splines would extrapolate beyond the bounds of the cell
+static inline int
+VU_PZ_N2_INL(int itab, double p, double z, double& vt, double& u, double& df_p, double& df_z) throw()
+{
+    const double h2=1./(NX2_VUPZN2-1);
+    const SBTL_COEF_N2 *data=SBTL_TAB_N2[itab];
+    if(!data) return I_ERR;
+//
+// cell of the nearest node in x1, then in x2 with the bounds of z at x1 (constant for t, which
+// keeps the two cell searches independent)
+    unsigned int i, j;
+    double dx1, x2;
+    if(!X_PZ_N2_INL(data, itab, p, z, i, dx1, x2)) return I_ERR;
+    if(!NODE_VUPZN2(x2, NX2_VUPZN2-1, NX2_VUPZN2, j)) return I_ERR;
+    const double dx2=x2-j*h2;
+//
+    const SBTL_COEF_N2 *val=&data[NCOEF_VUPZN2*(j*NX1_VUPZN2+i)];
+    vt=SPLINE_VU_N2(val, dx1, dx2);
+    u=SPLINE_VU_N2(val+9, dx1, dx2);
+    df_p=val[IDF_VUPZN2];
+    df_z=val[IDF_VUPZN2+1];
+#ifdef SBTL_FLOAT_TABLES
+    df_p+=DF_FLOAT_VUPZN2[0];
+    df_z+=DF_FLOAT_VUPZN2[1+itab-ITAB_VUPTN2];
+#endif
+    return I_OK;
+}
+//
+// vt and u at (p,t), (p,h) or (p,s) from the backward splines, with the residual bounds of the
+// cell (df_p relative, df_t, df_h or df_s absolute as the criteria of TOL_SBTL_N2); I_ERR if the
+// tables are not available or the state is out of the range of validity, in which case the
+// flashes start from the initial guess splines and always take Newton's method
+SBTLAPI int __stdcall VU_PT_N2(double p, double t, double& vt, double& u, double& df_p, double& df_t) throw()
+{
+    return VU_PZ_N2_INL(ITAB_VUPTN2, p, t, vt, u, df_p, df_t);
+}
+//
+SBTLAPI int __stdcall VU_PH_N2(double p, double h, double& vt, double& u, double& df_p, double& df_h) throw()
+{
+    return VU_PZ_N2_INL(ITAB_VUPHN2, p, h, vt, u, df_p, df_h);
+}
+//
+SBTLAPI int __stdcall VU_PS_N2(double p, double s, double& vt, double& u, double& df_p, double& df_s) throw()
+{
+    return VU_PZ_N2_INL(ITAB_VUPSN2, p, s, vt, u, df_p, df_s);
+}
+//
+// I_OK if (p,z) is in the grid of the backward splines 'itab' (ITAB_VUPTN2, ITAB_VUPHN2 or
+// ITAB_VUPSN2), i.e. in the range of validity like the backward splines see it, without
+// evaluating any spline
+SBTLAPI int __stdcall IN_RANGE_PZ_N2(int itab, double p, double z) throw()
+{
+    const SBTL_COEF_N2 *data=SBTL_TAB_N2[itab];
+    unsigned int i, j;
+    double dx1, x2;
+    if(!data || !X_PZ_N2_INL(data, itab, p, z, i, dx1, x2)) return I_ERR;
+    return NODE_VUPZN2(x2, NX2_VUPZN2-1, NX2_VUPZN2, j) ? I_OK : I_ERR;
+}
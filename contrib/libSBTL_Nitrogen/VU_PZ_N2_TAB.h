@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////////////
+// LibSBTL_vu_N2 - SBTL library for gaseous nitrogen based on:
+//
+// Span, R., Lemmon, E.W., Jacobsen, R.T, Wagner, W., and Yokozeki, A.:
+//
+//   "A Reference Equation of State for the Thermodynamic Properties of Nitrogen for Temperatures
+//   from 63.151 to 1000 K and Pressures to 2200 MPa," J. Phys. Chem. Ref. Data, 29(6):1361-1433,
+//   2000.
+//
+// Lemmon, E.W. and Jacobsen, R.T.:
+//
+//   "Viscosity and Thermal Conductivity Equations for Nitrogen, Oxygen, Argon, and Air"
+//   Int. J. Thermophys., 25:21-69, 2004.
+//
+// Copyright (C) Idaho National Laboratory.
+// All rights reserved.
+//
+// Disclaimer:
+// The Idaho National Laboratory (INL) uses its best efforts to deliver a high-quality software and
+// to verify that the computed information is correct. However, INL makes no warranties to that
+// effect, and INL shall not be liable for any damage that may result from errors or omissions in
+// the software.
+//
+// Version: 0.9.0
+//
+// VU_PZ_N2_TAB.h - grid and coefficient layout of the backward splines vt(p,z) and u(p,z) for
+// z = t, h and s, written by sbtl_n2_gen
+//
+///////////////////////////////////////////////////////////////////////////
+//
+#pragma once
+//
+#include "SBTL_TAB_N2.h"
+//
+// nodes in x1 = ln(p) from ln(PMIN_N2) to ln(PMAX_N2) and in
+// x2 = (z - zmin(p)) / (zmax(p) - zmin(p)) from 0 to 1, where zmin and zmax are z at TMIN_N2
+// and TMAX_N2; one cell per node, with the knots halfway between the nodes
+#define NX1_VUPZN2 141
+#define NX2_VUPZN2 91
+#define NCELL_VUPZN2 (NX1_VUPZN2 * NX2_VUPZN2)
+static const double X1_MIN_VUPZN2 = -7.6009024595420822; // ln(PMIN_N2)
+static const double X1_MAX_VUPZN2 = 4.6051701859880918; // ln(PMAX_N2)
+//
+// per cell (j * NX1_VUPZN2 + i): 9 coefficients of vt(x1,x2), 9 of u(x1,x2) (see SPLINE_VU_N2),
+// then the residual bounds of the cell, |p(vt,u) - p| / p and |z(vt,u) - z|
+#define NCOEF_VUPZN2 20
+#define IDF_VUPZN2 18
+// per node in x1, after the cells: 3 coefficients of zmin(x1), then 3 of 1 / (zmax - zmin)(x1)
+#define NBOUND_VUPZN2 6
+//
+// number of coefficients of a backward spline table
+#define NTAB_VUPZN2 (NCOEF_VUPZN2 * NCELL_VUPZN2 + NBOUND_VUPZN2 * NX1_VUPZN2)
@@ -0,0 +1,597 @@
+///////////////////////////////////////////////////////////////////////////
+// LibSBTL_vu_N2 - SBTL library for gaseous nitrogen based on:
+//
+// Span, R., Lemmon, E.W., Jacobsen, R.T, Wagner, W., and Yokozeki, A.:
+//
+//   "A Reference Equation of State for the Thermodynamic Properties of Nitrogen for Temperatures
+//   from 63.151 to 1000 K and Pressures to 2200 MPa," J. Phys. Chem. Ref. Data, 29(6):1361-1433,
+//   2000.
+//
+// Lemmon, E.W. and Jacobsen, R.T.:
+//
+//   "Viscosity and Thermal Conductivity Equations for Nitrogen, Oxygen, Argon, and Air"
+//   Int. J. Thermophys., 25:21-69, 2004.
+//
+// Copyright (C) Idaho National Laboratory.
+// All rights reserved.
+//
+// Disclaimer:
+// The Idaho National Laboratory (INL) uses its best efforts to deliver a high-quality software and
+// to verify that the computed information is correct. However, INL makes no warranties to that
+// effect, and INL shall not be liable for any damage that may result from errors or omissions in
+// the software.
+//
+// Version: 0.9.0
+//
+// SBTL_N2_BENCH - timings of the libSBTL_Nitrogen entry points
+//
+//   usage: sbtl_n2_bench [<points per distribution> [<repetitions>]]
+//
+// The state points cover the range of validity (0.0005 MPa <= p <= 100 MPa, 250 K <= T <= 1300 K)
+// and are drawn from three distributions:
+//   random     uniform in log(p) and T
+//   sorted     the random points sorted by p and T (neighbouring calls hit nearby cells)
+//   coherent   a random walk with small steps, like a cell over successive time steps
+// Each function is called for all points of a distribution; the fastest of the repetitions is
+// reported in ns per call and million calls per second (the array functions per point, with
+// VU_N2_NB(P) the cell-binned P_VU_N2_N and VU_N2_NB(all) all eight properties binned once, in a
+// workspace allocated once, and the *_WS(B) flashes with TOL_BACKWARD_N2).
+// Next, the thread-parallel functions are timed for the random points with 1, 2, 4, ... threads
+// up to the number of cores, with the speedup over one thread.
+//
+// Finally, the cell layouts of the forward splines (see OFFSET_VU_N2) are compared on copies of
+// the tables: row-major and tiles of 4, 8 and 16 cells. Each point evaluates all eight forward
+// splines in its cell and t(vt,u) in the neighbouring cells in u, as U_VT_N2 does. Where the
+// hardware counters are available (Linux perf events), the L1 data cache, last level cache and
+// data TLB misses per point are listed as well.
+//
+///////////////////////////////////////////////////////////////////////////
+//
+#include "math.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include "SBTL_N2.h"
+#include "SBTL_call_conv.h"
+#include "SBTL_TAB_N2.h"
+#include "VU_N2.h"
+//
+SBTLAPI double __stdcall P_VU_N2(double v, double u) throw();
+SBTLAPI double __stdcall S_VU_N2(double v, double u) throw();
+SBTLAPI void __stdcall P_VU_N2_N(const double * v, const double * u, double * p, size_t n) throw();
+SBTLAPI int __stdcall VU_N2_NB(int nprop,
+                               const int * iall,
+                               const double * v,
+                               const double * u,
+                               double * const * z,
+                               size_t n,
+                               double * work) throw();
+SBTLAPI size_t __stdcall VU_N2_NB_WORK(size_t n) throw();
+SBTLAPI void __stdcall DIFF_ALL_VU_N2_T(
+    double vt, double v, double u, double * z, double * dzdv, double * dzdu) throw();
+SBTLAPI double __stdcall U_VT_N2(double v, double t) throw();
+SBTLAPI int __stdcall FLASH_VH_N2(double v, double h, double & u) throw();
+SBTLAPI int __stdcall PT_FLASH_N2(double p, double t, double & v, double & vt, double & u) throw();
+SBTLAPI int __stdcall PT_FLASH_N2_WS(
+    double p, double t, double & v, double & vt, double & u, STR_vu_SBTL_N2 & st) throw();
+SBTLAPI int __stdcall PH_FLASH_N2(double p, double h, double & v, double & vt, double & u) throw();
+SBTLAPI int __stdcall PH_FLASH_N2_WS(
+    double p, double h, double & v, double & vt, double & u, STR_vu_SBTL_N2 & st) throw();
+SBTLAPI int __stdcall PS_FLASH_N2(double p, double s, double & v, double & vt, double & u) throw();
+SBTLAPI int __stdcall PS_FLASH_N2_WS(
+    double p, double s, double & v, double & vt, double & u, STR_vu_SBTL_N2 & st) throw();
+SBTLAPI int __stdcall HS_FLASH_N2(double h, double s, double & v, double & vt, double & u) throw();
+SBTLAPI int __stdcall VU_N2_NP(
+    int iall, const double * v, const double * u, double * z, size_t n, int nthreads) throw();
+SBTLAPI size_t __stdcall PT_FLASH_N2_NP(const double * p,
+                                        const double * t,
+                                        double * v,
+                                        double * vt,
+                                        double * u,
+                                        size_t n,
+                                        int nthreads) throw();
+//
+// range of validity
+static const double P_MIN_BENCH = 0.0005, P_MAX_BENCH = 100.;
+static const double T_MIN_BENCH = 250., T_MAX_BENCH = 1300.;
+//
+// state points of a distribution (MPa, K, kJ)
+struct POINTS_BENCH
+{
+  const char * name;
+  std::vector<double> p, t, v, vt, u, h, s;
+};
+//
+// completes a state point given by (p,t); false if the (p,T) flash fails
+static bool
+ADD_BENCH(POINTS_BENCH & pts, double p, double t)
+{
+  double v, vt, u;
+  if (PT_FLASH_N2(p, t, v, vt, u) != I_OK)
+    return false;
+  pts.p.push_back(p);
+  pts.t.push_back(t);
+  pts.v.push_back(v);
+  pts.vt.push_back(vt);
+  pts.u.push_back(u);
+  pts.h.push_back(u + p * v * 1.e3);
+  pts.s.push_back(S_VU_N2(v, u));
+  return true;
+}
+//
+// fastest time in ns per call of f(k) for all points k, over 'nrep' repetitions
+template <typename F>
+static double
+TIME_BENCH(size_t n, int nrep, F f, double & sink)
+{
+  double best = 1.e300;
+  for (int r = 0; r < nrep; r++)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t k = 0; k < n; k++)
+      sink += f(k);
+    const auto stop = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    if (ns < best)
+      best = ns;
+  }
+  return best / n;
+}
+//
+static void
+REPORT_BENCH(const char * fn, const POINTS_BENCH & pts, double ns)
+{
+  printf("%-18s %-10s %10.1f %12.3f\n", fn, pts.name, ns, 1.e3 / ns);
+}
+//
+// hardware counters of this thread: L1 data cache read misses, last level cache misses and data
+// TLB read misses (-1 where not available)
+#define NCOUNT_BENCH 3
+struct COUNTERS_BENCH
+{
+  int fd[NCOUNT_BENCH];
+
+  COUNTERS_BENCH()
+  {
+    for (int c = 0; c < NCOUNT_BENCH; c++)
+      fd[c] = -1;
+#ifdef __linux__
+    static const uint32_t type[NCOUNT_BENCH] = {
+        PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE};
+    static const uint64_t config[NCOUNT_BENCH] = {
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+    for (int c = 0; c < NCOUNT_BENCH; c++)
+    {
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = type[c];
+      attr.config = config[c];
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      fd[c] = (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+#endif
+  }
+
+  ~COUNTERS_BENCH()
+  {
+#ifdef __linux__
+    for (int c = 0; c < NCOUNT_BENCH; c++)
+      if (fd[c] >= 0)
+        close(fd[c]);
+#endif
+  }
+
+  // counts of f() in 'count'
+  template <typename F>
+  void measure(F f, long long * count)
+  {
+    for (int c = 0; c < NCOUNT_BENCH; c++)
+      count[c] = -1;
+#ifdef __linux__
+    for (int c = 0; c < NCOUNT_BENCH; c++)
+      if (fd[c] >= 0)
+      {
+        ioctl(fd[c], PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd[c], PERF_EVENT_IOC_ENABLE, 0);
+      }
+#endif
+    f();
+#ifdef __linux__
+    for (int c = 0; c < NCOUNT_BENCH; c++)
+      if (fd[c] >= 0)
+      {
+        ioctl(fd[c], PERF_EVENT_IOC_DISABLE, 0);
+        if (read(fd[c], &count[c], sizeof(count[c])) != sizeof(count[c]))
+          count[c] = -1;
+      }
+#endif
+  }
+};
+//
+// the forward splines of the library copied to cells in tiles of TILE cells
+template <unsigned int TILE>
+static std::vector<double>
+TILES_BENCH()
+{
+  const size_t stride = 9 * NCELL_TILE_VUN2(TILE);
+  std::vector<double> tab(NALL_VU_N2 * stride, 0.);
+  for (int k = 0; k < NALL_VU_N2; k++)
+    for (unsigned int j = 0; j < NX2_VUN2; j++)
+      for (unsigned int i = 0; i < NX1_VUN2; i++)
+      {
+        const double * val = CELL_VU_N2(SBTL_TAB_N2_DOUBLE[k], i, j);
+        std::copy(val, val + 9, &tab[k * stride + OFFSET_TILE_VU_N2(i, j, TILE)]);
+      }
+  return tab;
+}
+//
+// all forward splines at (vt[k],u[k]) and t(vt,u) in the neighbouring cells in u from the copy
+// 'tab' (the tables are ITAB_* = IALL_*)
+template <unsigned int TILE>
+static double
+CELLS_BENCH(const std::vector<double> & tab, const POINTS_BENCH & x, size_t k)
+{
+  const size_t stride = 9 * NCELL_TILE_VUN2(TILE);
+  unsigned int i, j;
+  double dx1, dx2;
+  IJ_VU_N2_T_INL(x.vt[k], x.u[k], i, j, dx1, dx2);
+
+  double sum = 0.;
+  for (int m = 0; m < NALL_VU_N2; m++)
+    sum += SPLINE_VU_N2(&tab[m * stride + OFFSET_TILE_VU_N2(i, j, TILE)], dx1, dx2);
+  const double * t = &tab[IALL_T * stride];
+  const unsigned int j_low = j > 0 ? j - 1 : 0;
+  const unsigned int j_high = j < NX2_VUN2 - 1 ? j + 1 : NX2_VUN2 - 1;
+  return sum + SPLINE_VU_N2(&t[OFFSET_TILE_VU_N2(i, j_low, TILE)], dx1, dx2) +
+         SPLINE_VU_N2(&t[OFFSET_TILE_VU_N2(i, j_high, TILE)], dx1, dx2);
+}
+//
+template <unsigned int TILE>
+static void
+LAYOUT_BENCH(const char * layout,
+             const POINTS_BENCH * const * all,
+             int nall,
+             int nrep,
+             COUNTERS_BENCH & counters,
+             double & sink)
+{
+  const std::vector<double> tab = TILES_BENCH<TILE>();
+  for (int d = 0; d < nall; d++)
+  {
+    const POINTS_BENCH & x = *all[d];
+    const size_t n = x.p.size();
+    auto f = [&tab, &x](size_t k) { return CELLS_BENCH<TILE>(tab, x, k); };
+    const double ns = TIME_BENCH(n, nrep, f, sink);
+
+    long long count[NCOUNT_BENCH];
+    counters.measure(
+        [&f, &sink, n]()
+        {
+          for (size_t k = 0; k < n; k++)
+            sink += f(k);
+        },
+        count);
+    printf("%-10s %-10s %10.1f", layout, x.name, ns);
+    for (int c = 0; c < NCOUNT_BENCH; c++)
+      if (count[c] >= 0)
+        printf(" %12.3f", (double)count[c] / n);
+      else
+        printf(" %12s", "n/a");
+    printf("\n");
+  }
+}
+//
+int
+main(int argc, char ** argv)
+{
+  if (argc > 3)
+  {
+    fprintf(stderr, "usage: %s [<points per distribution> [<repetitions>]]\n", argv[0]);
+    return 1;
+  }
+  const size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 100000;
+  const int nrep = argc > 2 ? atoi(argv[2]) : 5;
+  if (n == 0 || nrep <= 0)
+  {
+    fprintf(stderr, "the number of points and repetitions must be positive\n");
+    return 1;
+  }
+
+  std::mt19937_64 gen(12345);
+  std::uniform_real_distribution<double> uni(0., 1.);
+  std::normal_distribution<double> normal(0., 1.);
+  const double lnp_min = log(P_MIN_BENCH), lnp_max = log(P_MAX_BENCH);
+
+  POINTS_BENCH random, sorted, coherent;
+  random.name = "random";
+  sorted.name = "sorted";
+  coherent.name = "coherent";
+
+  while (random.p.size() < n)
+    ADD_BENCH(random,
+              exp(lnp_min + (lnp_max - lnp_min) * uni(gen)),
+              T_MIN_BENCH + (T_MAX_BENCH - T_MIN_BENCH) * uni(gen));
+
+  std::vector<size_t> order(n);
+  for (size_t k = 0; k < n; k++)
+    order[k] = k;
+  std::sort(order.begin(),
+            order.end(),
+            [&random](size_t a, size_t b)
+            {
+              return random.p[a] < random.p[b] ||
+                     (random.p[a] == random.p[b] && random.t[a] < random.t[b]);
+            });
+  for (size_t k = 0; k < n; k++)
+    ADD_BENCH(sorted, random.p[order[k]], random.t[order[k]]);
+
+  // steps of 0.2 % in p and 0.2 K in T, reflected at the bounds
+  double lnp = 0.5 * (lnp_min + lnp_max), t = 0.5 * (T_MIN_BENCH + T_MAX_BENCH);
+  while (coherent.p.size() < n)
+  {
+    lnp += 0.002 * normal(gen);
+    t += 0.2 * normal(gen);
+    if (lnp < lnp_min || lnp > lnp_max)
+      lnp = lnp < lnp_min ? 2. * lnp_min - lnp : 2. * lnp_max - lnp;
+    if (t < T_MIN_BENCH || t > T_MAX_BENCH)
+      t = t < T_MIN_BENCH ? 2. * T_MIN_BENCH - t : 2. * T_MAX_BENCH - t;
+    ADD_BENCH(coherent, exp(lnp), t);
+  }
+
+  printf("%zu points per distribution, best of %d repetitions\n", n, nrep);
+  printf("%-18s %-10s %10s %12s\n", "function", "inputs", "ns/call", "Mcalls/s");
+
+  double sink = 0.;
+  std::vector<double> z(n), zall(NALL_VU_N2 * n), work(VU_N2_NB_WORK(n));
+  int iall[NALL_VU_N2];
+  double * pall[NALL_VU_N2];
+  for (int l = 0; l < NALL_VU_N2; l++)
+  {
+    iall[l] = l;
+    pall[l] = &zall[l * n];
+  }
+  const POINTS_BENCH * all[] = {&random, &sorted, &coherent};
+  for (const POINTS_BENCH * pts : all)
+  {
+    const POINTS_BENCH & x = *pts;
+    double ns;
+
+    ns = TIME_BENCH(n, nrep, [&x](size_t k) { return P_VU_N2(x.v[k], x.u[k]); }, sink);
+    REPORT_BENCH("P_VU_N2", x, ns);
+
+    ns = TIME_BENCH(1,
+                    nrep,
+                    [&x, &z, n](size_t)
+                    {
+                      P_VU_N2_N(x.v.data(), x.u.data(), z.data(), n);
+                      return z[n - 1];
+                    },
+                    sink) /
+         n;
+    REPORT_BENCH("P_VU_N2_N", x, ns);
+
+    ns = TIME_BENCH(1,
+                    nrep,
+                    [&x, &z, &iall, &work, n](size_t)
+                    {
+                      double * pz = z.data();
+                      VU_N2_NB(1, iall, x.v.data(), x.u.data(), &pz, n, work.data());
+                      return z[n - 1];
+                    },
+                    sink) /
+         n;
+    REPORT_BENCH("VU_N2_NB(P)", x, ns);
+
+    ns = TIME_BENCH(1,
+                    nrep,
+                    [&x, &zall, &iall, &pall, &work, n](size_t)
+                    {
+                      VU_N2_NB(NALL_VU_N2, iall, x.v.data(), x.u.data(), pall, n, work.data());
+                      return zall[n - 1];
+                    },
+                    sink) /
+         n;
+    REPORT_BENCH("VU_N2_NB(all)", x, ns);
+
+    ns = TIME_BENCH(n,
+                    nrep,
+                    [&x](size_t k)
+                    {
+                      double zz[NALL_VU_N2], dzdv[NALL_VU_N2], dzdu[NALL_VU_N2];
+                      DIFF_ALL_VU_N2_T(x.vt[k], x.v[k], x.u[k], zz, dzdv, dzdu);
+                      return zz[IALL_P];
+                    },
+                    sink);
+    REPORT_BENCH("DIFF_ALL_VU_N2_T", x, ns);
+
+    ns = TIME_BENCH(n, nrep, [&x](size_t k) { return U_VT_N2(x.v[k], x.t[k]); }, sink);
+    REPORT_BENCH("U_VT_N2", x, ns);
+
+    ns = TIME_BENCH(n,
+                    nrep,
+                    [&x](size_t k)
+                    {
+                      double u;
+                      FLASH_VH_N2(x.v[k], x.h[k], u);
+                      return u;
+                    },
+                    sink);
+    REPORT_BENCH("FLASH_VH_N2", x, ns);
+
+    ns = TIME_BENCH(n,
+                    nrep,
+                    [&x](size_t k)
+                    {
+                      double v, vt, u;
+                      PT_FLASH_N2(x.p[k], x.t[k], v, vt, u);
+                      return v;
+                    },
+                    sink);
+    REPORT_BENCH("PT_FLASH_N2", x, ns);
+
+    STR_vu_SBTL_N2 st;
+    ns = TIME_BENCH(n,
+                    nrep,
+                    [&x, &st](size_t k)
+                    {
+                      double v, vt, u;
+                      PT_FLASH_N2_WS(x.p[k], x.t[k], v, vt, u, st);
+                      return v;
+                    },
+                    sink);
+    REPORT_BENCH("PT_FLASH_N2_WS", x, ns);
+
+    ns = TIME_BENCH(n,
+                    nrep,
+                    [&x](size_t k)
+                    {
+                      double v, vt, u;
+                      PH_FLASH_N2(x.p[k], x.h[k], v, vt, u);
+                      return v;
+                    },
+                    sink);
+    REPORT_BENCH("PH_FLASH_N2", x, ns);
+
+    ns = TIME_BENCH(n,
+                    nrep,
+                    [&x](size_t k)
+                    {
+                      double v, vt, u;
+                      PS_FLASH_N2(x.p[k], x.s[k], v, vt, u);
+                      return v;
+                    },
+                    sink);
+    REPORT_BENCH("PS_FLASH_N2", x, ns);
+
+    // the backward splines without Newton's method where they meet the criteria
+    STR_vu_SBTL_N2 st_bw;
+    st_bw.tol.set(TOL_BACKWARD_N2);
+    ns = TIME_BENCH(n,
+                    nrep,
+                    [&x, &st_bw](size_t k)
+                    {
+                      double v, vt, u;
+                      PT_FLASH_N2_WS(x.p[k], x.t[k], v, vt, u, st_bw);
+                      return v;
+                    },
+                    sink);
+    REPORT_BENCH("PT_FLASH_N2_WS(B)", x, ns);
+
+    ns = TIME_BENCH(n,
+                    nrep,
+                    [&x, &st_bw](size_t k)
+                    {
+                      double v, vt, u;
+                      PH_FLASH_N2_WS(x.p[k], x.h[k], v, vt, u, st_bw);
+                      return v;
+                    },
+                    sink);
+    REPORT_BENCH("PH_FLASH_N2_WS(B)", x, ns);
+
+    ns = TIME_BENCH(n,
+                    nrep,
+                    [&x, &st_bw](size_t k)
+                    {
+                      double v, vt, u;
+                      PS_FLASH_N2_WS(x.p[k], x.s[k], v, vt, u, st_bw);
+                      return v;
+                    },
+                    sink);
+    REPORT_BENCH("PS_FLASH_N2_WS(B)", x, ns);
+
+    ns = TIME_BENCH(n,
+                    nrep,
+                    [&x](size_t k)
+                    {
+                      double v, vt, u;
+                      HS_FLASH_N2(x.h[k], x.s[k], v, vt, u);
+                      return v;
+                    },
+                    sink);
+    REPORT_BENCH("HS_FLASH_N2", x, ns);
+  }
+
+  // thread scaling: a number of threads above the number of points per NMIN_PAR_N2 (4096) is
+  // capped by the functions, so use enough points to see it
+  const int ncores = std::max(1, (int)std::thread::hardware_concurrency());
+  std::vector<int> nthreads;
+  for (int nt = 1; nt < ncores; nt *= 2)
+    nthreads.push_back(nt);
+  nthreads.push_back(ncores);
+
+  printf("\nthread scaling, random points\n");
+  printf("%-18s %8s %10s %12s %8s\n", "function", "threads", "ns/point", "Mpoints/s", "speedup");
+  std::vector<double> v(n), vt(n), u(n);
+  double ns1 = 0.;
+  for (int nt : nthreads)
+  {
+    const double ns = TIME_BENCH(1,
+                                 nrep,
+                                 [&random, &z, n, nt](size_t)
+                                 {
+                                   VU_N2_NP(IALL_P, random.v.data(), random.u.data(), z.data(), n,
+                                            nt);
+                                   return z[n - 1];
+                                 },
+                                 sink) /
+                      n;
+    if (nt == 1)
+      ns1 = ns;
+    printf("%-18s %8d %10.2f %12.3f %8.2f\n", "VU_N2_NP(IALL_P)", nt, ns, 1.e3 / ns, ns1 / ns);
+  }
+  for (int nt : nthreads)
+  {
+    const double ns = TIME_BENCH(1,
+                                 nrep,
+                                 [&random, &v, &vt, &u, n, nt](size_t)
+                                 {
+                                   PT_FLASH_N2_NP(random.p.data(), random.t.data(), v.data(),
+                                                  vt.data(), u.data(), n, nt);
+                                   return v[n - 1];
+                                 },
+                                 sink) /
+                      n;
+    if (nt == 1)
+      ns1 = ns;
+    printf("%-18s %8d %10.2f %12.3f %8.2f\n", "PT_FLASH_N2_NP", nt, ns, 1.e3 / ns, ns1 / ns);
+  }
+
+  // cell layouts
+  printf("\ncell layout of the forward splines (library: %s), per point\n",
+         SBTL_TILE_N2 > 1 ? "tiled" : "row-major");
+  printf("%-10s %-10s %10s %12s %12s %12s\n",
+         "layout",
+         "inputs",
+         "ns",
+         "L1D misses",
+         "LLC misses",
+         "dTLB misses");
+  COUNTERS_BENCH counters;
+  LAYOUT_BENCH<1>("row-major", all, 3, nrep, counters, sink);
+  LAYOUT_BENCH<4>("tiles 4", all, 3, nrep, counters, sink);
+  LAYOUT_BENCH<8>("tiles 8", all, 3, nrep, counters, sink);
+  LAYOUT_BENCH<16>("tiles 16", all, 3, nrep, counters, sink);
+
+  // keeps the calls from being optimized away
+  if (sink == 0.)
+    printf("\n");
+  return 0;
+}
@@ -0,0 +1,1522 @@
+///////////////////////////////////////////////////////////////////////////
+// LibSBTL_vu_N2 - SBTL library for gaseous nitrogen based on:
+//
+// Span, R., Lemmon, E.W., Jacobsen, R.T, Wagner, W., and Yokozeki, A.:
+//
+//   "A Reference Equation of State for the Thermodynamic Properties of Nitrogen for Temperatures
+//   from 63.151 to 1000 K and Pressures to 2200 MPa," J. Phys. Chem. Ref. Data, 29(6):1361-1433,
+//   2000.
+//
+// Lemmon, E.W. and Jacobsen, R.T.:
+//
+//   "Viscosity and Thermal Conductivity Equations for Nitrogen, Oxygen, Argon, and Air"
+//   Int. J. Thermophys., 25:21-69, 2004.
+//
+// Copyright (C) Idaho National Laboratory.
+// All rights reserved.
+//
+// Disclaimer:
+// The Idaho National Laboratory (INL) uses its best efforts to deliver a high-quality software and
+// to verify that the computed information is correct. However, INL makes no warranties to that
+// effect, and INL shall not be liable for any damage that may result from errors or omissions in
+// the software.
+//
+// Version: 0.9.0
+//
+// SBTL_N2_GEN - generates the initial guess and backward splines of libSBTL_Nitrogen and table
+// files of all splines from the reference equations, and reports the accuracy of the splines
+//
+//   usage: sbtl_n2_gen UVTN2I <nodes in vt> <nodes in t> [<output directory>]
+//          sbtl_n2_gen UVHN2 <nodes in vt for v < 0.01> <nodes in vt for v > 0.01> <nodes in h>
+//                      [<output directory>]
+//          sbtl_n2_gen VUPZN2 <nodes in p> <nodes in z> [<output directory>]
+//          sbtl_n2_gen tables <table file>
+//          sbtl_n2_gen report [<table file>]
+//
+// UVTN2I and UVHN2 fit the initial guess spline u(vt,t) (U_VT_N2_INI.h/.cpp) or u(vt,h)
+// (U_VH_N2_INI.h/.cpp) with the given numbers of nodes over the ranges of the current splines and
+// write both files to the output directory (default: the current directory). The library has to be
+// rebuilt with them; table files written before do not fit the new grid and are rejected. Like
+// 'tables', UVTN2I fails if u(vt,t) is more than one cell of the forward spline t(vt,u) in use off
+// its root anywhere in the range of validity, which U_VT_N2 would have to search for.
+//
+// VUPZN2 fits the backward splines vt(p,z) and u(p,z) for z = t, h and s (VU_PZ_N2_TAB.h/.cpp)
+// with the given numbers of nodes, equidistant in ln(p) and in z between z at 250 K and 1300 K, to
+// the inverse of the forward splines in use, with the residual bounds of each cell (see
+// VU_PZ_N2.cpp), and writes them like UVTN2I. They have to be generated again whenever the forward
+// splines change.
+//
+// 'tables' fits all splines on the grids of the library: the forward and initial guess splines to
+// the reference equations, then the backward splines to the new forward splines, and writes them
+// to a table file (coefficient type and cell layout of the library). It needs no tables in use, so
+// it also serves a library built with SBTL_NO_EMBEDDED_TABLES.
+//
+// The splines are C1 continuous biquadratic tensor-product splines with the knots between the
+// nodes, which interpolate the reference equations at the nodes. In both dimensions, the boundary
+// cells also interpolate the neighbouring node.
+//
+// The accuracy report lists for each spline the maximum absolute, root mean square and maximum
+// relative deviation from the reference equations, with (p,T) of the maximum relative deviation.
+// The deviations are sampled at four points per cell, halfway between the node and the knots,
+// within the range of validity (0.0005 MPa <= p <= 100 MPa, 250 K <= T <= 1300 K). 'report'
+// lists all splines in use (of the table file, if given), 'tables' those written and the other
+// modes the new spline and the one in use. For the backward splines, it lists the largest residual
+// bounds and the share of the cells where they meet the criteria of TOL_FAST_N2, so that the
+// flashes with TOL_BACKWARD_N2 skip Newton's method.
+//
+// Reference equations (units of the library: MPa, kJ/kg, kJ/(kg K), m/s, Pa s, W/(m K)):
+//   thermodynamic properties    Span et al. (2000), see above
+//   viscosity and conductivity  Lemmon and Jacobsen (2004), including the critical enhancement
+//
+///////////////////////////////////////////////////////////////////////////
+//
+#include "math.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "SBTL_N2.h"
+#include "SBTL_call_conv.h"
+#include "SBTL_TAB_N2.h"
+#include "U_VH_N2_INI.h"
+#include "U_VT_N2_INI.h"
+#include "VU_N2.h"
+#include "VU_PZ_N2_TAB.h"
+//
+//-----------------------------------------------------------------------------
+// reference equations
+//-----------------------------------------------------------------------------
+//
+// critical point and specific gas constant of Span et al.
+static const double TC_GEN = 126.192;                      // K
+static const double RHOC_GEN = 11.1839 * 28.01348;         // kg/m^3
+static const double R_GEN = 8.31451 / 28.01348;            // kJ/(kg K)
+static const double M_GEN = 28.01348;                      // g/mol
+static const double PC_GEN = 3.3958;                       // MPa
+//
+// ideal gas part of the Helmholtz energy
+static const double a0_GEN[8] = {2.5,
+                                 -12.76952708,
+                                 -0.00784163,
+                                 -1.934819e-4,
+                                 -1.247742e-5,
+                                 6.678326e-8,
+                                 1.012941,
+                                 26.65788};
+//
+// residual part: n delta^d tau^t exp(-delta^l) (no exponential for l = 0) for the first 32 terms,
+// n delta^d tau^t exp(-phi (delta - 1)^2 - beta (tau - gamma)^2) for the last 4
+#define NR_GEN 36
+#define NG_GEN 4
+static const double n_GEN[NR_GEN] = {
+    0.924803575275,   -0.492448489428,  0.661883336938,    -1.92902649201,   -0.0622469309629,
+    0.349943957581,   0.564857472498,   -1.61720005987,    -0.481395031883,  0.421150636384,
+    -0.0161962230825, 0.172100994165,   0.00735448924933,  0.0168077305479,  -0.00107626664179,
+    -0.0137318088513, 0.000635466899859, 0.00304432279419, -0.0435762336045, -0.0723174889316,
+    0.0389644315272,  -0.021220136391,  0.00408822981509,  -5.51990017984e-5, -0.0462016716479,
+    -0.00300311716011, 0.0368825891208, -0.0025585684622,  0.00896915264558, -0.0044151337035,
+    0.00133722924858, 0.000264832491957, 19.6688194015,    -20.911560073,    0.0167788306989,
+    2627.67566274};
+static const int d_GEN[NR_GEN] = {1, 1, 2, 2, 3, 3, 1, 1, 1, 3, 3, 4, 6, 6, 7, 7, 8, 8,
+                                  1, 2, 3, 4, 5, 8, 4, 5, 5, 8, 3, 5, 6, 9, 1, 1, 3, 2};
+static const double t_GEN[NR_GEN] = {0.25, 0.875, 0.5, 0.875, 0.375, 0.75, 0.5, 0.75, 2.,
+                                     1.25, 3.5,   1.,  0.5,   3.,    0.,   2.75, 0.75, 2.5,
+                                     4.,   6.,    6.,  3.,    3.,    6.,   16.,  11.,  15.,
+                                     12.,  12.,   7.,  4.,    16.,   0.,   1.,   2.,   3.};
+static const int l_GEN[NR_GEN - NG_GEN] = {0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+                                           1, 1, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4};
+static const double phi_GEN[NG_GEN] = {20., 20., 15., 25.};
+static const double beta_GEN[NG_GEN] = {325., 325., 300., 275.};
+static const double gamma_GEN[NG_GEN] = {1.16, 1.16, 1.13, 1.25};
+//
+// Helmholtz energy and its reduced derivatives: a[0] = alpha, a[1] = delta alpha_delta,
+// a[2] = delta^2 alpha_delta_delta, a[3] = tau alpha_tau, a[4] = tau^2 alpha_tau_tau,
+// a[5] = delta tau alpha_delta_tau; ideal gas part a0, residual part ar
+static void
+ALPHA_GEN(double delta, double tau, double * a0, double * ar)
+{
+  const double e = exp(-a0_GEN[7] * tau);
+  a0[0] = log(delta) + a0_GEN[0] * log(tau) + a0_GEN[1] + a0_GEN[2] * tau + a0_GEN[3] / tau +
+          a0_GEN[4] / (tau * tau) + a0_GEN[5] / (tau * tau * tau) + a0_GEN[6] * log(1. - e);
+  a0[1] = 1.;
+  a0[2] = -1.;
+  a0[3] = a0_GEN[0] + a0_GEN[2] * tau - a0_GEN[3] / tau - 2. * a0_GEN[4] / (tau * tau) -
+          3. * a0_GEN[5] / (tau * tau * tau) + a0_GEN[6] * a0_GEN[7] * tau * e / (1. - e);
+  a0[4] = -a0_GEN[0] + 2. * a0_GEN[3] / tau + 6. * a0_GEN[4] / (tau * tau) +
+          12. * a0_GEN[5] / (tau * tau * tau) -
+          a0_GEN[6] * a0_GEN[7] * a0_GEN[7] * tau * tau * e / ((1. - e) * (1. - e));
+  a0[5] = 0.;
+
+  for (int m = 0; m < 6; m++)
+    ar[m] = 0.;
+  for (int k = 0; k < NR_GEN; k++)
+  {
+    // f = term, D = delta f_delta / f, DD = delta^2 f_delta_delta / f, T and TT likewise
+    double f, D, DD, T, TT;
+    if (k < NR_GEN - NG_GEN)
+    {
+      const double dl = l_GEN[k] > 0 ? pow(delta, l_GEN[k]) : 0.;
+      f = n_GEN[k] * pow(delta, d_GEN[k]) * pow(tau, t_GEN[k]) * exp(-dl);
+      D = d_GEN[k] - l_GEN[k] * dl;
+      DD = D * (D - 1.) - l_GEN[k] * l_GEN[k] * dl;
+      T = t_GEN[k];
+      TT = t_GEN[k] * (t_GEN[k] - 1.);
+    }
+    else
+    {
+      const int g = k - (NR_GEN - NG_GEN);
+      f = n_GEN[k] * pow(delta, d_GEN[k]) * pow(tau, t_GEN[k]) *
+          exp(-phi_GEN[g] * (delta - 1.) * (delta - 1.) -
+              beta_GEN[g] * (tau - gamma_GEN[g]) * (tau - gamma_GEN[g]));
+      D = d_GEN[k] - 2. * phi_GEN[g] * delta * (delta - 1.);
+      DD = D * D - d_GEN[k] - 2. * phi_GEN[g] * delta * delta;
+      T = t_GEN[k] - 2. * beta_GEN[g] * tau * (tau - gamma_GEN[g]);
+      TT = T * T - t_GEN[k] - 2. * beta_GEN[g] * tau * tau;
+    }
+    ar[0] += f;
+    ar[1] += f * D;
+    ar[2] += f * DD;
+    ar[3] += f * T;
+    ar[4] += f * TT;
+    ar[5] += f * D * T;
+  }
+}
+//
+// dilute gas viscosity in uPa s
+static double
+ETA0_GEN(double t)
+{
+  static const double b[5] = {0.431, -0.4623, 0.08406, 0.005341, -0.00331};
+  const double lnt = log(t / 98.94);
+  const double omega = exp(b[0] + lnt * (b[1] + lnt * (b[2] + lnt * (b[3] + lnt * b[4]))));
+  return 0.0266958 * sqrt(M_GEN * t) / (0.3656 * 0.3656 * omega);
+}
+//
+// sum of n tau^t delta^d exp(-gamma delta^l) of the residual transport terms
+static double
+RES_GEN(int nt,
+        const double * n,
+        const double * t,
+        const int * d,
+        const int * l,
+        const int * gamma,
+        double tau,
+        double delta)
+{
+  double sum = 0.;
+  for (int k = 0; k < nt; k++)
+    sum += n[k] * pow(tau, t[k]) * pow(delta, d[k]) * exp(-gamma[k] * pow(delta, l[k]));
+  return sum;
+}
+//
+// state point and its properties
+struct STATE_GEN
+{
+  double v, t, p, u, h, s, w, cp, cv, eta, lambda;
+  double dudt_v, dhdt_v;
+};
+//
+// (drho/dp)_t in kg/(m^3 MPa)
+static double
+DRHODP_GEN(double rho, double t)
+{
+  double a0[6], ar[6];
+  ALPHA_GEN(rho / RHOC_GEN, TC_GEN / t, a0, ar);
+  return 1.e3 / (R_GEN * t * (1. + 2. * ar[1] + ar[2]));
+}
+//
+// all properties at (v,t); transport properties only if 'transport'
+static void
+STATE_VT_GEN(double v, double t, STATE_GEN & st, bool transport)
+{
+  const double rho = 1. / v, delta = rho / RHOC_GEN, tau = TC_GEN / t;
+  double a0[6], ar[6];
+  ALPHA_GEN(delta, tau, a0, ar);
+
+  const double x = 1. + ar[1] - ar[5];
+  st.v = v;
+  st.t = t;
+  st.p = rho * R_GEN * t * (1. + ar[1]) * 1.e-3;
+  st.u = R_GEN * t * (a0[3] + ar[3]);
+  st.h = st.u + st.p * v * 1.e3;
+  st.s = R_GEN * (a0[3] + ar[3] - a0[0] - ar[0]);
+  st.cv = -R_GEN * (a0[4] + ar[4]);
+  st.cp = st.cv + R_GEN * x * x / (1. + 2. * ar[1] + ar[2]);
+  st.w = sqrt(1.e3 * R_GEN * t * (1. + 2. * ar[1] + ar[2] - x * x / (a0[4] + ar[4])));
+  st.dudt_v = st.cv;
+  st.dhdt_v = st.cv + R_GEN * x;
+  st.eta = st.lambda = 0.;
+  if (!transport)
+    return;
+
+  // viscosity (uPa s)
+  static const double n_eta[5] = {10.72, 0.03989, 0.001208, -7.402, 4.620};
+  static const double t_eta[5] = {0.1, 0.25, 3.2, 0.9, 0.3};
+  static const int d_eta[5] = {2, 10, 12, 2, 1};
+  static const int l_eta[5] = {0, 1, 1, 2, 3};
+  static const int g_eta[5] = {0, 1, 1, 1, 1};
+  const double eta0 = ETA0_GEN(t);
+  const double eta = eta0 + RES_GEN(5, n_eta, t_eta, d_eta, l_eta, g_eta, tau, delta);
+
+  // thermal conductivity (mW/(m K)): dilute gas, residual and critical enhancement
+  static const double n_lambda[6] = {8.862, 31.11, -73.13, 20.03, -0.7096, 0.2672};
+  static const double t_lambda[6] = {0., 0.03, 0.2, 0.8, 0.6, 1.9};
+  static const int d_lambda[6] = {1, 2, 3, 4, 8, 10};
+  static const int l_lambda[6] = {0, 0, 1, 2, 2, 2};
+  static const int g_lambda[6] = {0, 0, 1, 1, 1, 1};
+  double lambda = 1.511 * eta0 + 2.117 / tau - 3.332 * pow(tau, -0.7) +
+                  RES_GEN(6, n_lambda, t_lambda, d_lambda, l_lambda, g_lambda, tau, delta);
+
+  static const double t_ref = 252.384;
+  const double chi = PC_GEN * rho / (RHOC_GEN * RHOC_GEN) *
+                     (DRHODP_GEN(rho, t) - t_ref / t * DRHODP_GEN(rho, t_ref));
+  if (chi > 0.)
+  {
+    const double xi = 0.17e-9 * pow(chi / 0.055, 0.63 / 1.2415);
+    const double y = xi / 0.40e-9;
+    const double omega =
+        2. / M_PI * ((st.cp - st.cv) / st.cp * atan(y) + st.cv / st.cp * y);
+    const double omega0 =
+        2. / M_PI *
+        (1. - exp(-1. / (1. / y + y * y / 3. * (RHOC_GEN / rho) * (RHOC_GEN / rho))));
+    lambda += rho * st.cp * 1.e3 * 1.01 * 1.380658e-23 * t / (6. * M_PI * xi * eta * 1.e-6) *
+              (omega - omega0) * 1.e3;
+  }
+
+  st.eta = eta * 1.e-6;
+  st.lambda = lambda * 1.e-3;
+}
+//
+// state point at (v,u), or (v,h) if 'enthalpy', by Newton's method in t (false if it fails)
+static bool
+STATE_VZ_GEN(double v, double z, bool enthalpy, STATE_GEN & st, bool transport)
+{
+  double t = 300.;
+  for (int it = 0; it < 100; it++)
+  {
+    STATE_VT_GEN(v, t, st, false);
+    const double dt =
+        enthalpy ? (z - st.h) / st.dhdt_v : (z - st.u) / st.dudt_v;
+    if (!(st.dudt_v > 0.) || !(st.dhdt_v > 0.))
+      return false;
+    t += std::max(-0.5 * t, std::min(dt, t));
+    if (fabs(dt) < 1.e-12 * t)
+    {
+      STATE_VT_GEN(v, t, st, transport);
+      return true;
+    }
+  }
+  return false;
+}
+//
+//-----------------------------------------------------------------------------
+// splines
+//-----------------------------------------------------------------------------
+//
+// range of validity
+static const double P_MIN_GEN = 0.0005, P_MAX_GEN = 100.;
+static const double T_MIN_GEN = 250., T_MAX_GEN = 1300.;
+//
+// nodes and knots of a dimension (transformed), made of subdivisions with equidistant nodes
+struct AXIS_GEN
+{
+  bool log;                  // transformation log(x)
+  std::vector<double> bound; // subdivision boundaries (not transformed)
+  std::vector<int> nodes;    // nodes per subdivision (neighbours share the boundary node)
+  std::vector<double> x, rs; // nodes and knots between them (and beyond the first and last)
+};
+//
+static void
+NODES_GEN(AXIS_GEN & ax)
+{
+  ax.x.clear();
+  for (size_t k = 0; k < ax.nodes.size(); k++)
+  {
+    const double x0 = ax.log ? log(ax.bound[k]) : ax.bound[k];
+    const double x1 = ax.log ? log(ax.bound[k + 1]) : ax.bound[k + 1];
+    for (int m = k > 0 ? 1 : 0; m < ax.nodes[k]; m++)
+      ax.x.push_back(m == ax.nodes[k] - 1 ? x1 : x0 + (x1 - x0) * m / (ax.nodes[k] - 1));
+  }
+  const size_t n = ax.x.size();
+  ax.rs.resize(n + 1);
+  ax.rs[0] = ax.x[0] - 0.5 * (ax.x[1] - ax.x[0]);
+  for (size_t i = 1; i < n; i++)
+    ax.rs[i] = 0.5 * (ax.x[i - 1] + ax.x[i]);
+  ax.rs[n] = ax.x[n - 1] + 0.5 * (ax.x[n - 1] - ax.x[n - 2]);
+}
+//
+// axis of given nodes with the knots halfway between them
+static AXIS_GEN
+AXIS_NODES_GEN(const double * x, size_t n)
+{
+  AXIS_GEN ax;
+  ax.log = false;
+  ax.x.assign(x, x + n);
+  ax.rs.resize(n + 1);
+  ax.rs[0] = x[0] - 0.5 * (x[1] - x[0]);
+  for (size_t i = 1; i < n; i++)
+    ax.rs[i] = 0.5 * (x[i - 1] + x[i]);
+  ax.rs[n] = x[n - 1] + 0.5 * (x[n - 1] - x[n - 2]);
+  return ax;
+}
+//
+// coefficients (f, b, c) of q(dx) = f + b dx + c dx^2 for each cell of the C1 quadratic spline
+// interpolating f[i * stride] at the nodes; the boundary cells also interpolate the neighbouring
+// node. The knot values g solve a tridiagonal system.
+static void
+FIT_1D_GEN(const AXIS_GEN & ax, const double * f, size_t stride, double * coef)
+{
+  const size_t n = ax.x.size();
+  std::vector<double> lo(n + 1), di(n + 1), up(n + 1), rhs(n + 1), g(n + 1);
+  // cell i: half widths l and r, q(-l) = g[i], q(r) = g[i+1]
+  auto l = [&ax](size_t i) { return ax.x[i] - ax.rs[i]; };
+  auto r = [&ax](size_t i) { return ax.rs[i + 1] - ax.x[i]; };
+  auto fi = [f, stride](size_t i) { return f[i * stride]; };
+
+  // q(dx) = f + (g0 - f) dx (dx - r) / (l (l + r)) + (g1 - f) dx (dx + l) / (r (l + r)): rows
+  // for q_i(x_{i+1} - x_i) = f_{i+1} at the first and q_i(x_{i-1} - x_i) = f_{i-1} at the last
+  // cell, and for the continuity of q' at the knots in between
+  for (size_t k = 0; k <= n; k++)
+  {
+    if (k == 0 || k == n)
+    {
+      const size_t i = k == 0 ? 0 : n - 1, m = k == 0 ? 1 : n - 2;
+      const double dx = ax.x[m] - ax.x[i], li = l(i), ri = r(i);
+      const double c0 = dx * (dx - ri) / (li * (li + ri)), c1 = dx * (dx + li) / (ri * (li + ri));
+      lo[k] = k == 0 ? 0. : c0;
+      di[k] = k == 0 ? c0 : c1;
+      up[k] = k == 0 ? c1 : 0.;
+      rhs[k] = fi(m) - fi(i) + fi(i) * (c0 + c1);
+      continue;
+    }
+    // q_{k-1}'(r) = q_k'(-l)
+    const double la = l(k - 1), ra = r(k - 1), lb = l(k), rb = r(k);
+    const double da = la * ra * (la + ra), db = lb * rb * (lb + rb);
+    lo[k] = ra * ra / da;
+    di[k] = (la * la + 2. * la * ra) / da + (rb * rb + 2. * rb * lb) / db;
+    up[k] = lb * lb / db;
+    rhs[k] = fi(k - 1) * (la + ra) * (la + ra) / da + fi(k) * (lb + rb) * (lb + rb) / db;
+  }
+
+  // Thomas algorithm
+  for (size_t k = 1; k <= n; k++)
+  {
+    const double w = lo[k] / di[k - 1];
+    di[k] -= w * up[k - 1];
+    rhs[k] -= w * rhs[k - 1];
+  }
+  g[n] = rhs[n] / di[n];
+  for (size_t k = n; k-- > 0;)
+    g[k] = (rhs[k] - up[k] * g[k + 1]) / di[k];
+
+  for (size_t i = 0; i < n; i++)
+  {
+    const double li = l(i), ri = r(i), d = li * ri * (li + ri);
+    const double e0 = g[i] - fi(i), e1 = g[i + 1] - fi(i);
+    coef[3 * i] = fi(i);
+    coef[3 * i + 1] = (li * li * e1 - ri * ri * e0) / d;
+    coef[3 * i + 2] = (ri * e0 + li * e1) / d;
+  }
+}
+//
+// 9 coefficients per cell (j * n1 + i) of the tensor-product spline of the node values
+// z[j * n1 + i], first fitted in x1 and then each of the three coefficients in x2
+static void
+FIT_2D_GEN(const AXIS_GEN & ax1,
+           const AXIS_GEN & ax2,
+           const std::vector<double> & z,
+           std::vector<double> & data)
+{
+  const size_t n1 = ax1.x.size(), n2 = ax2.x.size();
+  std::vector<double> c1(3 * n1 * n2), c2(3 * n2);
+  for (size_t j = 0; j < n2; j++)
+    FIT_1D_GEN(ax1, &z[j * n1], 1, &c1[3 * j * n1]);
+
+  data.resize(9 * n1 * n2);
+  for (size_t i = 0; i < n1; i++)
+    for (int m = 0; m < 3; m++)
+    {
+      FIT_1D_GEN(ax2, &c1[3 * i + m], 3 * n1, &c2[0]);
+      for (size_t j = 0; j < n2; j++)
+        for (int k = 0; k < 3; k++)
+          data[9 * (j * n1 + i) + 3 * m + k] = c2[3 * j + k];
+    }
+}
+//
+// a spline: its grid and coefficients (double, or the tables of the library)
+struct SPLINE_GEN
+{
+  const char * name;
+  AXIS_GEN ax1, ax2;
+  const double * data;
+  const SBTL_COEF_N2 * table;
+  bool forward; // table in the cell layout of the forward splines (see OFFSET_VU_N2)
+};
+//
+static double
+EVAL_GEN(const SPLINE_GEN & sp, double x1, double x2)
+{
+  const size_t n1 = sp.ax1.x.size(), n2 = sp.ax2.x.size();
+  size_t i = std::upper_bound(sp.ax1.rs.begin() + 1, sp.ax1.rs.end() - 1, x1) - sp.ax1.rs.begin();
+  size_t j = std::upper_bound(sp.ax2.rs.begin() + 1, sp.ax2.rs.end() - 1, x2) - sp.ax2.rs.begin();
+  i = std::min(i - 1, n1 - 1);
+  j = std::min(j - 1, n2 - 1);
+  const double dx1 = x1 - sp.ax1.x[i], dx2 = x2 - sp.ax2.x[j];
+  if (sp.data)
+    return SPLINE_VU_N2(&sp.data[9 * (j * n1 + i)], dx1, dx2);
+  return SPLINE_VU_N2(sp.forward ? CELL_VU_N2(sp.table, i, j) : &sp.table[9 * (j * n1 + i)],
+                      dx1,
+                      dx2);
+}
+//
+//-----------------------------------------------------------------------------
+// accuracy report
+//-----------------------------------------------------------------------------
+//
+// kind of spline: forward spline z(vt,u) of property IALL_*, or the initial guess u(vt,t) or
+// u(vt,h)
+#define KIND_UVT_GEN NALL_VU_N2
+#define KIND_UVH_GEN (NALL_VU_N2 + 1)
+//
+static double
+PROPERTY_GEN(const STATE_GEN & st, int kind)
+{
+  switch (kind)
+  {
+    case IALL_P:
+      return st.p;
+    case IALL_T:
+      return st.t;
+    case IALL_S:
+      return st.s;
+    case IALL_W:
+      return st.w;
+    case IALL_CP:
+      return st.cp;
+    case IALL_CV:
+      return st.cv;
+    case IALL_ETA:
+      return st.eta;
+    case IALL_LAMBDA:
+      return st.lambda;
+    default:
+      return st.u;
+  }
+}
+//
+static void
+REPORT_HEADER_GEN()
+{
+  printf("%-22s %8s %12s %12s %12s %12s %10s\n",
+         "spline",
+         "points",
+         "max abs",
+         "rms",
+         "max rel",
+         "at p (MPa)",
+         "t (K)");
+}
+//
+static void
+REPORT_GEN(const SPLINE_GEN & sp, int kind)
+{
+  const bool transport = kind == IALL_ETA || kind == IALL_LAMBDA;
+  size_t npt = 0;
+  double max_abs = 0., sum_sq = 0., max_rel = 0., p_rel = 0., t_rel = 0.;
+  const AXIS_GEN & ax1 = sp.ax1;
+  const AXIS_GEN & ax2 = sp.ax2;
+  for (size_t j = 0; j < ax2.x.size(); j++)
+    for (size_t i = 0; i < ax1.x.size(); i++)
+      for (int m = 0; m < 4; m++)
+      {
+        // halfway between the node and the knots
+        const double x1 = m & 1 ? 0.5 * (ax1.x[i] + ax1.rs[i + 1]) : 0.5 * (ax1.x[i] + ax1.rs[i]);
+        const double x2 = m & 2 ? 0.5 * (ax2.x[j] + ax2.rs[j + 1]) : 0.5 * (ax2.x[j] + ax2.rs[j]);
+        const double v = exp(x1);
+        STATE_GEN st;
+        if (kind == KIND_UVT_GEN)
+          STATE_VT_GEN(v, x2, st, false);
+        else if (!STATE_VZ_GEN(v, x2, kind == KIND_UVH_GEN, st, transport))
+          continue;
+        if (st.p < P_MIN_GEN || st.p > P_MAX_GEN || st.t < T_MIN_GEN || st.t > T_MAX_GEN)
+          continue;
+
+        const double z_ref = PROPERTY_GEN(st, kind);
+        const double dev = fabs(EVAL_GEN(sp, x1, x2) - z_ref);
+        npt++;
+        sum_sq += dev * dev;
+        max_abs = std::max(max_abs, dev);
+        if (dev > max_rel * fabs(z_ref))
+        {
+          max_rel = dev / fabs(z_ref);
+          p_rel = st.p;
+          t_rel = st.t;
+        }
+      }
+  printf("%-22s %8zu %12.4e %12.4e %12.4e %12.6g %10.6g\n",
+         sp.name,
+         npt,
+         max_abs,
+         npt > 0 ? sqrt(sum_sq / npt) : 0.,
+         max_rel,
+         p_rel,
+         t_rel);
+}
+//
+// the spline 'itab' of the library
+static SPLINE_GEN
+SPLINE_TAB_GEN(int itab, const char * name)
+{
+  SPLINE_GEN sp;
+  sp.name = name;
+  sp.data = NULL;
+  sp.table = SBTL_TAB_N2[itab];
+  sp.forward = itab <= ITAB_LAMBDAVUN2;
+  if (itab == ITAB_UVTN2I)
+  {
+    sp.ax1 = AXIS_NODES_GEN(x1_UVTN2I, NX1_UVTN2I);
+    sp.ax2 = AXIS_NODES_GEN(x2_UVTN2I, NX2_UVTN2I);
+  }
+  else if (itab == ITAB_UVHN2)
+  {
+    sp.ax1 = AXIS_NODES_GEN(x1_UVHN2, NX1_UVHN2);
+    sp.ax2 = AXIS_NODES_GEN(x2_UVHN2, NX2_UVHN2);
+  }
+  else
+  {
+    sp.ax1 = AXIS_NODES_GEN(x1_VUN2, NX1_VUN2);
+    sp.ax2 = AXIS_NODES_GEN(x2_VUN2, NX2_VUN2);
+    sp.ax1.rs.assign(x1_RS_VUN2, x1_RS_VUN2 + NX1_VUN2 + 1);
+    sp.ax2.rs.assign(x2_RS_VUN2, x2_RS_VUN2 + NX2_VUN2 + 1);
+  }
+  return sp;
+}
+//
+//-----------------------------------------------------------------------------
+// forward and initial guess splines
+//-----------------------------------------------------------------------------
+//
+// triple point temperature, the lower limit of the reference equations
+static const double T_TRIPLE_GEN = 63.151; // K
+//
+// forward splines z(vt,u) of all properties (tables ITAB_PVUN2 to ITAB_LAMBDAVUN2) on the grid of
+// the library, in its cell layout. The grid extends beyond the range of validity to low u, where
+// the nodes without a state point above the triple point take the values of the nearest node in u
+// with one.
+static bool
+FIT_FORWARD_GEN(std::vector<double> * tab)
+{
+  const size_t n1 = NX1_VUN2, n2 = NX2_VUN2, n = n1 * n2;
+  std::vector<double> z(NALL_VU_N2 * n), data;
+  std::vector<char> ok(n);
+  for (size_t j = 0; j < n2; j++)
+    for (size_t i = 0; i < n1; i++)
+    {
+      STATE_GEN st;
+      const size_t l = j * n1 + i;
+      ok[l] = STATE_VZ_GEN(exp(x1_VUN2[i]), x2_VUN2[j], false, st, true) && st.t > T_TRIPLE_GEN;
+      for (int k = 0; k < NALL_VU_N2 && ok[l]; k++)
+        z[k * n + l] = PROPERTY_GEN(st, k);
+    }
+  for (size_t i = 0; i < n1; i++)
+    for (size_t j = 0; j < n2; j++)
+    {
+      if (ok[j * n1 + i])
+        continue;
+      size_t jj = n2;
+      for (size_t d = 1; d < n2 && jj == n2; d++)
+        if (j + d < n2 && ok[(j + d) * n1 + i])
+          jj = j + d;
+        else if (j >= d && ok[(j - d) * n1 + i])
+          jj = j - d;
+      if (jj == n2)
+      {
+        fprintf(stderr, "no state point at v=%g\n", exp(x1_VUN2[i]));
+        return false;
+      }
+      for (int k = 0; k < NALL_VU_N2; k++)
+        z[k * n + j * n1 + i] = z[k * n + jj * n1 + i];
+    }
+
+  AXIS_GEN ax1 = AXIS_NODES_GEN(x1_VUN2, n1), ax2 = AXIS_NODES_GEN(x2_VUN2, n2);
+  ax1.rs.assign(x1_RS_VUN2, x1_RS_VUN2 + n1 + 1);
+  ax2.rs.assign(x2_RS_VUN2, x2_RS_VUN2 + n2 + 1);
+  // the tables ITAB_*VUN2 are in the order of the IALL_* indices
+  for (int k = 0; k < NALL_VU_N2; k++)
+  {
+    const std::vector<double> zk(z.begin() + k * n, z.begin() + (k + 1) * n);
+    FIT_2D_GEN(ax1, ax2, zk, data);
+    tab[k].assign(SBTL_TAB_N2_COUNT[k], 0.);
+    for (size_t j = 0; j < n2; j++)
+      for (size_t i = 0; i < n1; i++)
+        memcpy(&tab[k][OFFSET_VU_N2(i, j)], &data[9 * (j * n1 + i)], 9 * sizeof(double));
+  }
+  return true;
+}
+//
+// initial guess spline u(vt,t) ('uvt') or u(vt,h) on the given grid (false if a node has no state
+// point)
+static bool
+FIT_INI_GEN(bool uvt, const AXIS_GEN & ax1, const AXIS_GEN & ax2, std::vector<double> & data)
+{
+  const size_t n1 = ax1.x.size(), n2 = ax2.x.size();
+  std::vector<double> z(n1 * n2);
+  for (size_t j = 0; j < n2; j++)
+    for (size_t i = 0; i < n1; i++)
+    {
+      STATE_GEN st;
+      const double v = exp(ax1.x[i]);
+      if (uvt)
+        STATE_VT_GEN(v, ax2.x[j], st, false);
+      else if (!STATE_VZ_GEN(v, ax2.x[j], true, st, false))
+      {
+        fprintf(stderr, "no state point at v=%g, h=%g\n", v, ax2.x[j]);
+        return false;
+      }
+      z[j * n1 + i] = st.u;
+    }
+  FIT_2D_GEN(ax1, ax2, z, data);
+  return true;
+}
+//
+// forward splines in use (ALL_VU_N2.cpp, U_VT_N2.cpp)
+SBTLAPI double __stdcall Z_VU_N2_T(int iall, double vt, double u);
+SBTLAPI double __stdcall U_VZ_N2(int iall, double v, double z);
+//
+// points per cell and direction of CELLS_OFF_UVT_GEN
+#define NS_UVT_GEN 8
+//
+// largest number of cells by which the initial guess u(vt,t) 'sp' misses the cell of the forward
+// spline t(vt,u) in use that contains the root, at NS_UVT_GEN x NS_UVT_GEN points of each cell of
+// the guess within the range of validity. U_VT_N2 takes the root of the neighbor cell without a
+// search, so the guess must not be more than one cell off.
+static int
+CELLS_OFF_UVT_GEN(const SPLINE_GEN & sp)
+{
+  int off_max = 0;
+  const AXIS_GEN & ax1 = sp.ax1;
+  const AXIS_GEN & ax2 = sp.ax2;
+  for (size_t j = 0; j < ax2.x.size(); j++)
+    for (size_t i = 0; i < ax1.x.size(); i++)
+      for (int m1 = 0; m1 < NS_UVT_GEN; m1++)
+        for (int m2 = 0; m2 < NS_UVT_GEN; m2++)
+        {
+          const double vt = ax1.rs[i] + (ax1.rs[i + 1] - ax1.rs[i]) * (m1 + 0.5) / NS_UVT_GEN;
+          const double t = ax2.rs[j] + (ax2.rs[j + 1] - ax2.rs[j]) * (m2 + 0.5) / NS_UVT_GEN;
+          if (t < T_MIN_GEN || t > T_MAX_GEN)
+            continue;
+          const double u = U_VZ_N2(IALL_T, exp(vt), t);
+          const double p = Z_VU_N2_T(IALL_P, vt, u);
+          if (p < P_MIN_GEN || p > P_MAX_GEN)
+            continue;
+
+          unsigned int i_cell, j_root, j_guess;
+          double dx1, dx2;
+          IJ_VU_N2_T_INL(vt, u, i_cell, j_root, dx1, dx2);
+          IJ_VU_N2_T_INL(vt, EVAL_GEN(sp, vt, t), i_cell, j_guess, dx1, dx2);
+          off_max = std::max(off_max, abs((int)j_root - (int)j_guess));
+        }
+  return off_max;
+}
+//
+// false with a message if the initial guess u(vt,t) 'sp' is more than one cell off
+static bool
+CHECK_UVT_GEN(const SPLINE_GEN & sp)
+{
+  const int off = CELLS_OFF_UVT_GEN(sp);
+  if (off <= 1)
+    return true;
+  fprintf(stderr,
+          "the initial guess u(vt,t) is up to %d cells off the root of t(vt,u), at most 1 is "
+          "allowed: use more nodes\n",
+          off);
+  return false;
+}
+//
+//-----------------------------------------------------------------------------
+// backward splines
+//-----------------------------------------------------------------------------
+//
+// forward splines in use with their derivatives w.r.t. vt and u (ALL_VU_N2.cpp)
+SBTLAPI void __stdcall DIFF_Z_VU_N2_TT(
+    int iall, double vt, double u, double & z, double & dzdv, double & dzdu, double & dudv);
+SBTLAPI void __stdcall DIFF_PT_VU_N2_TT(double vt,
+                                       double u,
+                                       double & p,
+                                       double & dpdv,
+                                       double & dpdu,
+                                       double & t,
+                                       double & dtdv,
+                                       double & dtdu);
+SBTLAPI void __stdcall DIFF_PS_VU_N2_TT(double vt,
+                                       double u,
+                                       double & p,
+                                       double & dpdv,
+                                       double & dpdu,
+                                       double & s,
+                                       double & dsdv,
+                                       double & dsdu);
+//
+// second variable z of the backward splines vt(p,z) and u(p,z), in the order of their tables
+// ITAB_VUPTN2, ITAB_VUPHN2 and ITAB_VUPSN2
+#define Z_T_GEN 0
+#define Z_H_GEN 1
+#define Z_S_GEN 2
+#define NZ_GEN 3
+static const char * name_Z_GEN[NZ_GEN] = {"t", "h", "s"};
+static const char * data_Z_GEN[NZ_GEN] = {"data_VUPTN2", "data_VUPHN2", "data_VUPSN2"};
+//
+// residual bounds of a cell: the largest residual at (2 NS_BW_GEN + 1)^2 points of the cell times
+// SF_BW_GEN (the residuals vary on the scale of the forward cells, several per backward cell)
+#define NS_BW_GEN 4
+#define SF_BW_GEN 2.
+//
+static double
+Z_GEN(const STATE_GEN & st, int kind)
+{
+  return kind == Z_T_GEN ? st.t : (kind == Z_H_GEN ? st.h : st.s);
+}
+//
+// state point at (p,t) by Newton's method in vt (false if it fails)
+static bool
+STATE_PT_GEN(double p, double t, STATE_GEN & st)
+{
+  double vt = log(R_GEN * t / (p * 1.e3));
+  for (int it = 0; it < 100; it++)
+  {
+    STATE_VT_GEN(exp(vt), t, st, false);
+    // (d ln(p) / d vt)_t = -rho (dp/drho)_t / p
+    const double dlnp = -1. / (st.v * DRHODP_GEN(1. / st.v, t) * st.p);
+    if (!(dlnp < 0.))
+      return false;
+    const double dvt = log(p / st.p) / dlnp;
+    vt += std::max(-1., std::min(dvt, 1.));
+    if (fabs(dvt) < 1.e-13)
+    {
+      STATE_VT_GEN(exp(vt), t, st, false);
+      return true;
+    }
+  }
+  return false;
+}
+//
+// state point at (p,z) by Newton's method in t (false if it fails)
+static bool
+STATE_PZ_GEN(double p, double z, int kind, STATE_GEN & st)
+{
+  if (kind == Z_T_GEN)
+    return STATE_PT_GEN(p, z, st);
+  double t = 500.;
+  for (int it = 0; it < 100; it++)
+  {
+    if (!STATE_PT_GEN(p, t, st))
+      return false;
+    // (dh/dt)_p = cp, (ds/dt)_p = cp / t
+    const double dt = kind == Z_H_GEN ? (z - st.h) / st.cp : (z - st.s) * t / st.cp;
+    t += std::max(-0.5 * t, std::min(dt, t));
+    if (fabs(dt) < 1.e-12 * t)
+      return STATE_PT_GEN(p, t, st);
+  }
+  return false;
+}
+//
+// p and z with their derivatives w.r.t. vt and u from the forward splines in use
+static void
+PZ_SPLINE_GEN(int kind,
+              double vt,
+              double u,
+              double & p,
+              double & dpdv,
+              double & dpdu,
+              double & z,
+              double & dzdv,
+              double & dzdu)
+{
+  if (kind == Z_T_GEN)
+    DIFF_PT_VU_N2_TT(vt, u, p, dpdv, dpdu, z, dzdv, dzdu);
+  else if (kind == Z_S_GEN)
+    DIFF_PS_VU_N2_TT(vt, u, p, dpdv, dpdu, z, dzdv, dzdu);
+  else
+  {
+    double dudv;
+    const double v = exp(vt);
+    DIFF_Z_VU_N2_TT(IALL_P, vt, u, p, dpdv, dpdu, dudv);
+    z = u + p * v * 1.e3;
+    dzdv = (dpdv + p) * v * 1.e3;
+    dzdu = 1. + dpdu * v * 1.e3;
+  }
+}
+//
+// (vt,u) at (p,z) of the forward splines in use by Newton's method, converged to round-off from
+// the state point 'st' of the reference equations (false if it does not converge)
+static bool
+PZ_NEWTON_GEN(int kind, double p, double z, const STATE_GEN & st, double & vt, double & u)
+{
+  vt = log(st.v);
+  u = st.u;
+  for (int it = 0; it < 50; it++)
+  {
+    double px, dpdv, dpdu, zx, dzdv, dzdu;
+    PZ_SPLINE_GEN(kind, vt, u, px, dpdv, dpdu, zx, dzdv, dzdu);
+    const double f_p = px - p, f_z = zx - z, den = dzdu * dpdv - dzdv * dpdu;
+    const double dvt = (-dzdu * f_p + f_z * dpdu) / den, du = (-f_z * dpdv + dzdv * f_p) / den;
+    vt += dvt;
+    u += du;
+    if (fabs(dvt) < 1.e-13 && fabs(du) < 1.e-13 * (1. + fabs(u)))
+      return true;
+  }
+  return false;
+}
+//
+// backward splines vt(p,z) and u(p,z) of 'kind' with n1 x n2 nodes, inverting the forward splines
+// in use, in the layout of VU_PZ_N2_TAB.h (false if a node cannot be inverted)
+//
+// Nodes: x1 = ln(p) from ln(P_MIN_GEN) to ln(P_MAX_GEN), and x2 = (z - zmin(x1)) / (zmax(x1) -
+// zmin(x1)) from 0 to 1, where zmin and zmax are z of the forward splines at T_MIN_GEN and
+// T_MAX_GEN (quadratic splines interpolating them at the nodes in x1). The residual bounds of each
+// cell cover the residuals of the forward splines in use and of the reference equations, so that
+// they also hold for forward splines fitted anew to the reference equations.
+static bool
+FIT_BW_GEN(int kind, int n1, int n2, std::vector<double> & tab)
+{
+  AXIS_GEN ax1, ax2;
+  ax1.log = true;
+  ax1.bound = {P_MIN_GEN, P_MAX_GEN};
+  ax1.nodes = {n1};
+  ax2.log = false;
+  ax2.bound = {0., 1.};
+  ax2.nodes = {n2};
+  NODES_GEN(ax1);
+  NODES_GEN(ax2);
+  tab.assign(NCOEF_VUPZN2 * n1 * n2 + NBOUND_VUPZN2 * n1, 0.);
+  double * bound = &tab[NCOEF_VUPZN2 * n1 * n2];
+
+  // bounds of x2 at the nodes in x1
+  std::vector<double> zb(2 * n1), c(3 * n1);
+  for (int i = 0; i < n1; i++)
+  {
+    const double p = exp(ax1.x[i]);
+    double zt[2] = {T_MIN_GEN, T_MAX_GEN};
+    for (int k = 0; k < 2 && kind != Z_T_GEN; k++)
+    {
+      STATE_GEN st;
+      double vt, u, px, dpdv, dpdu, dzdv, dzdu;
+      if (!STATE_PT_GEN(p, zt[k], st) || !PZ_NEWTON_GEN(Z_T_GEN, p, zt[k], st, vt, u))
+      {
+        fprintf(stderr, "cannot invert the forward splines at p=%g, t=%g\n", p, zt[k]);
+        return false;
+      }
+      PZ_SPLINE_GEN(kind, vt, u, px, dpdv, dpdu, zt[k], dzdv, dzdu);
+    }
+    zb[i] = zt[0];
+    zb[n1 + i] = 1. / (zt[1] - zt[0]);
+  }
+  for (int m = 0; m < 2; m++)
+  {
+    FIT_1D_GEN(ax1, &zb[m * n1], 1, &c[0]);
+    for (int i = 0; i < n1; i++)
+      for (int k = 0; k < 3; k++)
+        bound[NBOUND_VUPZN2 * i + 3 * m + k] = c[3 * i + k];
+  }
+
+  // node values and tensor-product fit of vt, then u
+  std::vector<double> zv(n1 * n2), zu(n1 * n2), data;
+  for (int j = 0; j < n2; j++)
+    for (int i = 0; i < n1; i++)
+    {
+      const double p = exp(ax1.x[i]), z = zb[i] + ax2.x[j] / zb[n1 + i];
+      STATE_GEN st;
+      if (!STATE_PZ_GEN(p, z, kind, st) ||
+          !PZ_NEWTON_GEN(kind, p, z, st, zv[j * n1 + i], zu[j * n1 + i]))
+      {
+        fprintf(stderr,
+                "cannot invert the forward splines at p=%g, %s=%g\n",
+                p,
+                name_Z_GEN[kind],
+                z);
+        return false;
+      }
+    }
+  for (int l = 0; l < 2; l++)
+  {
+    FIT_2D_GEN(ax1, ax2, l == 0 ? zv : zu, data);
+    for (int k = 0; k < n1 * n2; k++)
+      for (int m = 0; m < 9; m++)
+        tab[NCOEF_VUPZN2 * k + 9 * l + m] = data[9 * k + m];
+  }
+
+  // residual bounds, sampled on a grid of 1/(2 NS_BW_GEN) of the cell within the range of validity
+  for (int j = 0; j < n2; j++)
+    for (int i = 0; i < n1; i++)
+    {
+      double * val = &tab[NCOEF_VUPZN2 * (j * n1 + i)];
+      const double * b = &bound[NBOUND_VUPZN2 * i];
+      double df_p = 0., df_z = 0.;
+      for (int k1 = i > 0 ? -NS_BW_GEN : 0; k1 <= (i < n1 - 1 ? NS_BW_GEN : 0); k1++)
+        for (int k2 = j > 0 ? -NS_BW_GEN : 0; k2 <= (j < n2 - 1 ? NS_BW_GEN : 0); k2++)
+        {
+          const double dx1 = (k1 < 0 ? ax1.x[i] - ax1.rs[i] : ax1.rs[i + 1] - ax1.x[i]) * k1 /
+                             NS_BW_GEN;
+          const double dx2 = (k2 < 0 ? ax2.x[j] - ax2.rs[j] : ax2.rs[j + 1] - ax2.x[j]) * k2 /
+                             NS_BW_GEN;
+          const double p = exp(ax1.x[i] + dx1);
+          const double z = b[0] + dx1 * (b[1] + dx1 * b[2]) +
+                           (ax2.x[j] + dx2) / (b[3] + dx1 * (b[4] + dx1 * b[5]));
+          const double vt = SPLINE_VU_N2(val, dx1, dx2), u = SPLINE_VU_N2(val + 9, dx1, dx2);
+          double px, dpdv, dpdu, zx, dzdv, dzdu;
+          PZ_SPLINE_GEN(kind, vt, u, px, dpdv, dpdu, zx, dzdv, dzdu);
+          df_p = std::max(df_p, fabs(px - p) / p);
+          df_z = std::max(df_z, fabs(zx - z));
+          STATE_GEN st;
+          if (!STATE_VZ_GEN(exp(vt), u, false, st, false))
+          {
+            fprintf(stderr, "no state point at v=%g, u=%g\n", exp(vt), u);
+            return false;
+          }
+          df_p = std::max(df_p, fabs(st.p - p) / p);
+          df_z = std::max(df_z, fabs(Z_GEN(st, kind) - z));
+        }
+      val[IDF_VUPZN2] = SF_BW_GEN * df_p;
+      val[IDF_VUPZN2 + 1] = SF_BW_GEN * df_z;
+    }
+  return true;
+}
+//
+// residual bounds of the backward splines 'tab' of 'kind' with n1 x n2 cells: largest bounds and
+// share of the cells where they meet the criteria of TOL_FAST_N2, i.e. where the (p,z) flashes
+// with TOL_BACKWARD_N2 skip Newton's method
+template <typename COEF>
+static void
+REPORT_BW_GEN(const char * name, int kind, const COEF * tab, int n1, int n2)
+{
+  TOL_SBTL_N2 tol;
+  tol.set(TOL_FAST_N2);
+  const double df_z = kind == Z_T_GEN ? tol.df_t : (kind == Z_H_GEN ? tol.df_h : tol.df_s);
+  double max_p = 0., max_z = 0.;
+  int n_ok = 0;
+  for (int k = 0; k < n1 * n2; k++)
+  {
+    const COEF * val = &tab[NCOEF_VUPZN2 * k];
+    max_p = std::max(max_p, (double)val[IDF_VUPZN2]);
+    max_z = std::max(max_z, (double)val[IDF_VUPZN2 + 1]);
+    n_ok += val[IDF_VUPZN2] <= tol.df_p && val[IDF_VUPZN2 + 1] <= df_z;
+  }
+  printf("%-22s %8d %12.4e %12.4e %11.2f%%\n",
+         name,
+         n1 * n2,
+         max_p,
+         max_z,
+         100. * n_ok / (n1 * n2));
+}
+//
+static void
+REPORT_BW_HEADER_GEN()
+{
+  printf("%-22s %8s %12s %12s %12s\n",
+         "backward spline",
+         "cells",
+         "max df_p",
+         "max df_z",
+         "no Newton");
+}
+//
+//-----------------------------------------------------------------------------
+// source files of the initial guess splines
+//-----------------------------------------------------------------------------
+//
+// description of a generated spline
+struct OUTPUT_GEN
+{
+  const char * file;  // U_VT_N2_INI or U_VH_N2_INI
+  const char * tab;   // UVTN2I or UVHN2
+  const char * itab;  // ITAB_UVTN2I or ITAB_UVHN2
+  const char * func;  // inline function
+  const char * x2;    // name of the second argument
+  const char * descr; // description
+};
+//
+static const char * head_GEN =
+    "///////////////////////////////////////////////////////////////////////////\n"
+    "// LibSBTL_vu_N2 - SBTL library for gaseous nitrogen based on:\n"
+    "//\n"
+    "// Span, R., Lemmon, E.W., Jacobsen, R.T, Wagner, W., and Yokozeki, A.:\n"
+    "//\n"
+    "//   \"A Reference Equation of State for the Thermodynamic Properties of Nitrogen for "
+    "Temperatures\n"
+    "//   from 63.151 to 1000 K and Pressures to 2200 MPa,\" J. Phys. Chem. Ref. Data, "
+    "29(6):1361-1433,\n"
+    "//   2000.\n"
+    "//\n"
+    "// Lemmon, E.W. and Jacobsen, R.T.:\n"
+    "//\n"
+    "//   \"Viscosity and Thermal Conductivity Equations for Nitrogen, Oxygen, Argon, and Air\"\n"
+    "//   Int. J. Thermophys., 25:21-69, 2004.\n"
+    "//\n"
+    "// Copyright (C) Idaho National Laboratory.\n"
+    "// All rights reserved.\n"
+    "//\n"
+    "// Disclaimer:\n"
+    "// The Idaho National Laboratory (INL) uses its best efforts to deliver a high-quality "
+    "software and\n"
+    "// to verify that the computed information is correct. However, INL makes no warranties to "
+    "that\n"
+    "// effect, and INL shall not be liable for any damage that may result from errors or "
+    "omissions in\n"
+    "// the software.\n"
+    "//\n"
+    "// Version: 0.9.0\n"
+    "//\n";
+//
+// writes n values, 10 per line
+static void
+WRITE_ARRAY_GEN(FILE * f, const char * decl, const double * x, size_t n)
+{
+  fprintf(f, "%s[%zu] = {", decl, n);
+  for (size_t k = 0; k < n; k++)
+    fprintf(f, "%s%.14g%s", k % 10 == 0 ? "\n    " : "", x[k], k + 1 < n ? "," : "\n");
+  fprintf(f, "};\n");
+}
+//
+// grid description of a dimension in the header comment
+static void
+WRITE_AXIS_GEN(FILE * f, const char * name, const AXIS_GEN & ax)
+{
+  fprintf(f, "//   %s:\n", name);
+  fprintf(f, "//     transformation: %s\n", ax.log ? "log(x1_val)" : "none");
+  fprintf(f, "//     subdivisions: %zu\n", ax.nodes.size());
+  fprintf(f, "//       %s_min=%g\n", name, ax.bound[0]);
+  for (size_t k = 0; k < ax.nodes.size(); k++)
+  {
+    fprintf(f, "//         nodes: %d\n", ax.nodes[k]);
+    if (k + 1 < ax.nodes.size())
+      fprintf(f, "//       %s_sub_%zu=%g\n", name, k + 1, ax.bound[k + 1]);
+  }
+  fprintf(f, "//       %s_max=%g\n", name, ax.bound.back());
+}
+//
+// cell search of a dimension with one or two subdivisions
+static void
+WRITE_SEARCH_GEN(FILE * f, const char * x, const char * idx, const char * nx, const AXIS_GEN & ax)
+{
+  if (ax.nodes.size() == 1)
+  {
+    fprintf(f, "  %sf = (%s - %s_sub_RS_0) * dist_%s_inv_0;\n", idx, x, idx, idx);
+    fprintf(f, "  if (%sf > 0.)\n  {\n", idx);
+    fprintf(f, "    %c = IROUND(%sf);\n", idx[1] == '1' ? 'i' : 'j', idx);
+    fprintf(f, "    if (%c > %s - 1)\n", idx[1] == '1' ? 'i' : 'j', nx);
+    fprintf(f, "      %c = %s - 1;\n  }\n  else\n    %c = 0;\n", idx[1] == '1' ? 'i' : 'j', nx,
+            idx[1] == '1' ? 'i' : 'j');
+    return;
+  }
+  const char c = idx[1] == '1' ? 'i' : 'j';
+  const int ib = ax.nodes[0] - 1;
+  fprintf(f, "  if (%s > ZS_1)\n  {\n", x);
+  fprintf(f, "    %sf = (%s - ZS_1) * dist_%s_inv_1;\n", idx, x, idx);
+  fprintf(f, "    %c = IROUND(%sf) + %d;\n", c, idx, ib + 1);
+  fprintf(f, "    if (%c > %s - 1)\n      %c = %s - 1;\n  }\n", c, nx, c, nx);
+  fprintf(f, "  else if (%s < %s_sub_RS_1)\n  {\n", x, idx);
+  fprintf(f, "    %sf = (%s - %s_sub_RS_0) * dist_%s_inv_0;\n", idx, x, idx, idx);
+  fprintf(f, "    if (%sf > 0.)\n      %c = IROUND(%sf);\n    else\n      %c = 0;\n  }\n", idx, c,
+          idx, c);
+  fprintf(f, "  else\n  {\n    %c = %d;\n  }\n", c, ib);
+}
+//
+// constants of the cell search of a dimension
+static void
+WRITE_CONST_GEN(FILE * f, const char * idx, const AXIS_GEN & ax)
+{
+  fprintf(f, "  static const double %s_sub_RS_0 = %.14g;\n", idx, ax.rs[0]);
+  if (ax.nodes.size() > 1)
+  {
+    const int ib = ax.nodes[0] - 1;
+    fprintf(f, "  static const double %s_sub_RS_1 = %.14g;\n", idx, ax.rs[ib]);
+    fprintf(f, "  static const double ZS_1 = %.14g;\n", ax.rs[ib + 1]);
+  }
+  for (size_t k = 0; k < ax.nodes.size(); k++)
+  {
+    const int i0 = k == 0 ? 0 : ax.nodes[0] - 1;
+    fprintf(f, "  static const double dist_%s_inv_%zu = %.14g;\n", idx, k,
+            1. / (ax.x[i0 + 1] - ax.x[i0]));
+  }
+}
+//
+static bool
+WRITE_GEN(const std::string & dir,
+          const OUTPUT_GEN & out,
+          const AXIS_GEN & ax1,
+          const AXIS_GEN & ax2,
+          const std::vector<double> & data)
+{
+  char date[64];
+  const time_t now = time(NULL);
+  strftime(date, sizeof(date), "Date: %Y-%m-%d Time: %H:%M:%S", localtime(&now));
+  const size_t n1 = ax1.x.size(), n2 = ax2.x.size();
+
+  // header: grid size and the inline spline function
+  const std::string h_path = dir + "/" + out.file + ".h";
+  FILE * f = fopen(h_path.c_str(), "w");
+  if (!f)
+  {
+    fprintf(stderr, "cannot write %s\n", h_path.c_str());
+    return false;
+  }
+  fprintf(f, "%s", head_GEN);
+  fprintf(f,
+          "// %s.h - cell search of the initial guess spline %s, written by sbtl_n2_gen\n//\n",
+          out.file,
+          out.descr);
+  fprintf(f, "///////////////////////////////////////////////////////////////////////////\n//\n");
+  fprintf(f, "#pragma once\n//\n#include \"SBTL_def.h\"\n#include \"SBTL_TAB_N2.h\"\n//\n");
+  fprintf(f, "// number of cells in x1 (vt) and x2 (%s)\n", out.x2);
+  fprintf(f, "#define NX1_%s %zu\n#define NX2_%s %zu\n//\n", out.tab, n1, out.tab, n2);
+  fprintf(f, "extern const double x1_%s[];\nextern const double x2_%s[];\n//\n", out.tab, out.tab);
+  fprintf(f, "// initial guess %s\n", out.descr);
+  fprintf(f, "inline double\n%s(double vt, double %s) throw()\n{\n", out.func, out.x2);
+  fprintf(f, "  unsigned int i, j;\n  double x1f, x2f;\n\n");
+  WRITE_CONST_GEN(f, "x1", ax1);
+  WRITE_CONST_GEN(f, "x2", ax2);
+  fprintf(f, "\n");
+  const std::string nx1 = std::string("NX1_") + out.tab, nx2 = std::string("NX2_") + out.tab;
+  WRITE_SEARCH_GEN(f, "vt", "x1", nx1.c_str(), ax1);
+  fprintf(f, "\n");
+  WRITE_SEARCH_GEN(f, out.x2, "x2", nx2.c_str(), ax2);
+  fprintf(f, "\n  const SBTL_COEF_N2 * val = &SBTL_TAB_N2[%s][9 * (j * %s + i)];\n", out.itab,
+          nx1.c_str());
+  fprintf(f, "  const double dx1 = vt - x1_%s[i];\n", out.tab);
+  fprintf(f, "  const double dx2 = %s - x2_%s[j];\n\n", out.x2, out.tab);
+  fprintf(f, "  return val[0] + dx2 * (val[1] + dx2 * val[2]) +\n");
+  fprintf(f, "         dx1 * (val[3] + dx2 * (val[4] + dx2 * val[5]) +\n");
+  fprintf(f, "                dx1 * (val[6] + dx2 * (val[7] + dx2 * val[8])));\n}\n");
+  const bool h_ok = fclose(f) == 0;
+
+  // source: grid and coefficients
+  const std::string c_path = dir + "/" + out.file + ".cpp";
+  f = fopen(c_path.c_str(), "w");
+  if (!h_ok || !f)
+  {
+    fprintf(stderr, "cannot write %s\n", h_ok ? c_path.c_str() : h_path.c_str());
+    return false;
+  }
+  fprintf(f, "%s", head_GEN);
+  fprintf(f, "// %s - initial guess spline %s, generated by sbtl_n2_gen\n//\n// %s\n//\n",
+          out.file, out.descr, date);
+  fprintf(f, "///////////////////////////////////////////////////////////////////////////\n//\n");
+  fprintf(f, "// Knots between the nodes.\n// Nodes: dimensions and transformations:\n");
+  WRITE_AXIS_GEN(f, "x1", ax1);
+  WRITE_AXIS_GEN(f, "x2", ax2);
+  fprintf(f, "//\n#include \"SBTL_call_conv.h\"\n#include \"%s.h\"\n//\n", out.file);
+  if (strcmp(out.tab, "UVHN2") == 0)
+    fprintf(f, "SBTLAPI double __stdcall U_VH_N2_INI_T(double vt, double h) throw()\n"
+               "{\n  return %s(vt, h);\n}\n//\n", out.func);
+  WRITE_ARRAY_GEN(f, (std::string("const double x1_") + out.tab).c_str(), &ax1.x[0], n1);
+  fprintf(f, "/*\n");
+  WRITE_ARRAY_GEN(f, (std::string("const double x1_RS_") + out.tab).c_str(), &ax1.rs[0], n1 + 1);
+  fprintf(f, "*/\n");
+  WRITE_ARRAY_GEN(f, (std::string("const double x2_") + out.tab).c_str(), &ax2.x[0], n2);
+  fprintf(f, "/*\n");
+  WRITE_ARRAY_GEN(f, (std::string("const double x2_RS_") + out.tab).c_str(), &ax2.rs[0], n2 + 1);
+  fprintf(f, "*/\n#ifndef SBTL_NO_EMBEDDED_TABLES\n");
+  fprintf(f, "// external linkage: referenced by the table registry (SBTL_TAB_N2.cpp)\n");
+  fprintf(f, "extern const double data_%s[];\n", out.tab);
+  WRITE_ARRAY_GEN(f, (std::string("const double data_") + out.tab).c_str(), &data[0], data.size());
+  fprintf(f, "#endif\n");
+  if (fclose(f) != 0)
+  {
+    fprintf(stderr, "cannot write %s\n", c_path.c_str());
+    return false;
+  }
+  printf("wrote %s and %s\n", h_path.c_str(), c_path.c_str());
+  return true;
+}
+//
+// writes VU_PZ_N2_TAB.h (grid and layout) and VU_PZ_N2_TAB.cpp (coefficients) of the backward
+// splines 'tab' (of ITAB_VUPTN2, ITAB_VUPHN2 and ITAB_VUPSN2) with n1 x n2 nodes
+static bool
+WRITE_BW_GEN(const std::string & dir, int n1, int n2, const std::vector<double> * tab)
+{
+  char date[64];
+  const time_t now = time(NULL);
+  strftime(date, sizeof(date), "Date: %Y-%m-%d Time: %H:%M:%S", localtime(&now));
+
+  const std::string h_path = dir + "/VU_PZ_N2_TAB.h";
+  FILE * f = fopen(h_path.c_str(), "w");
+  if (!f)
+  {
+    fprintf(stderr, "cannot write %s\n", h_path.c_str());
+    return false;
+  }
+  fprintf(f, "%s", head_GEN);
+  fprintf(f,
+          "// VU_PZ_N2_TAB.h - grid and coefficient layout of the backward splines vt(p,z) and "
+          "u(p,z) for\n// z = t, h and s, written by sbtl_n2_gen\n//\n");
+  fprintf(f, "///////////////////////////////////////////////////////////////////////////\n//\n");
+  fprintf(f, "#pragma once\n//\n#include \"SBTL_TAB_N2.h\"\n//\n");
+  fprintf(f,
+          "// nodes in x1 = ln(p) from ln(PMIN_N2) to ln(PMAX_N2) and in\n// x2 = (z - zmin(p)) / "
+          "(zmax(p) - zmin(p)) from 0 to 1, where zmin and zmax are z at TMIN_N2\n// and TMAX_N2; "
+          "one cell per node, with the knots halfway between the nodes\n");
+  fprintf(f, "#define NX1_VUPZN2 %d\n#define NX2_VUPZN2 %d\n", n1, n2);
+  fprintf(f, "#define NCELL_VUPZN2 (NX1_VUPZN2 * NX2_VUPZN2)\n");
+  fprintf(f, "static const double X1_MIN_VUPZN2 = %.17g; // ln(PMIN_N2)\n", log(P_MIN_GEN));
+  fprintf(f, "static const double X1_MAX_VUPZN2 = %.17g; // ln(PMAX_N2)\n//\n", log(P_MAX_GEN));
+  fprintf(f,
+          "// per cell (j * NX1_VUPZN2 + i): 9 coefficients of vt(x1,x2), 9 of u(x1,x2) (see "
+          "SPLINE_VU_N2),\n// then the residual bounds of the cell, |p(vt,u) - p| / p and "
+          "|z(vt,u) - z|\n");
+  fprintf(f, "#define NCOEF_VUPZN2 20\n#define IDF_VUPZN2 18\n");
+  fprintf(f,
+          "// per node in x1, after the cells: 3 coefficients of zmin(x1), then 3 of 1 / (zmax - "
+          "zmin)(x1)\n");
+  fprintf(f, "#define NBOUND_VUPZN2 6\n//\n// number of coefficients of a backward spline table\n");
+  fprintf(f, "#define NTAB_VUPZN2 (NCOEF_VUPZN2 * NCELL_VUPZN2 + NBOUND_VUPZN2 * NX1_VUPZN2)\n");
+  const bool h_ok = fclose(f) == 0;
+
+  const std::string c_path = dir + "/VU_PZ_N2_TAB.cpp";
+  f = fopen(c_path.c_str(), "w");
+  if (!h_ok || !f)
+  {
+    fprintf(stderr, "cannot write %s\n", h_ok ? c_path.c_str() : h_path.c_str());
+    return false;
+  }
+  fprintf(f, "%s", head_GEN);
+  fprintf(f,
+          "// VU_PZ_N2_TAB - backward splines vt(p,z) and u(p,z) for z = t, h and s, generated "
+          "by sbtl_n2_gen\n//\n// %s\n//\n",
+          date);
+  fprintf(f, "///////////////////////////////////////////////////////////////////////////\n//\n");
+  fprintf(f,
+          "// The splines interpolate the inverse of the forward splines at the nodes. The "
+          "residual bounds\n// of each cell are %g times the largest residual of the forward "
+          "splines and of the reference\n// equations at %d x %d points of the cell. "
+          "sbtl_n2_validate checks them against the forward\n// splines of the library.\n//\n",
+          SF_BW_GEN,
+          2 * NS_BW_GEN + 1,
+          2 * NS_BW_GEN + 1);
+  fprintf(f, "#include \"VU_PZ_N2_TAB.h\"\n//\n#ifndef SBTL_NO_EMBEDDED_TABLES\n");
+  fprintf(f, "// external linkage: referenced by the table registry (SBTL_TAB_N2.cpp)\n");
+  for (int kind = 0; kind < NZ_GEN; kind++)
+  {
+    fprintf(f, "extern const double %s[];\n", data_Z_GEN[kind]);
+    const std::string decl = std::string("const double ") + data_Z_GEN[kind];
+    WRITE_ARRAY_GEN(f, decl.c_str(), &tab[kind][0], tab[kind].size());
+  }
+  fprintf(f, "#endif\n");
+  if (fclose(f) != 0)
+  {
+    fprintf(stderr, "cannot write %s\n", c_path.c_str());
+    return false;
+  }
+  printf("wrote %s and %s\n", h_path.c_str(), c_path.c_str());
+  return true;
+}
+//
+// uses the double tables 'data' as table k (rounded to float with SBTL_FLOAT_TABLES)
+static void
+USE_GEN(int k, const std::vector<double> & data)
+{
+  static std::vector<SBTL_COEF_N2> coef[NTAB_N2];
+  coef[k].assign(data.begin(), data.end());
+  SBTL_TAB_N2_DOUBLE[k] = &data[0];
+  SBTL_TAB_N2[k] = &coef[k][0];
+}
+//
+static int
+USAGE_GEN(const char * exe)
+{
+  fprintf(stderr,
+          "usage: %s UVTN2I <nodes in vt> <nodes in t> [<output directory>]\n"
+          "       %s UVHN2 <nodes in vt for v < 0.01> <nodes in vt for v > 0.01> <nodes in h> "
+          "[<output directory>]\n"
+          "       %s VUPZN2 <nodes in p> <nodes in z> [<output directory>]\n"
+          "       %s tables <table file>\n"
+          "       %s report [<table file>]\n",
+          exe,
+          exe,
+          exe,
+          exe,
+          exe);
+  return 1;
+}
+//
+int
+main(int argc, char ** argv)
+{
+  if (argc < 2)
+    return USAGE_GEN(argv[0]);
+
+  static const char * name_VU[NALL_VU_N2] = {"p(vt,u)",
+                                             "t(vt,u)",
+                                             "s(vt,u)",
+                                             "w(vt,u)",
+                                             "cp(vt,u)",
+                                             "cv(vt,u)",
+                                             "eta(vt,u)",
+                                             "lambda(vt,u)"};
+  static const char * name_BW[NZ_GEN] = {"vt,u(p,t)", "vt,u(p,h)", "vt,u(p,s)"};
+  if (strcmp(argv[1], "report") == 0)
+  {
+    if (argc > 3)
+      return USAGE_GEN(argv[0]);
+    if (argc > 2 && SBTL_TAB_N2_LOAD(argv[2]) != I_OK)
+    {
+      fprintf(stderr, "%s\n", SBTL_TAB_N2_ERROR());
+      return 1;
+    }
+    if (SBTL_TAB_N2_READY() != I_OK)
+    {
+      fprintf(stderr, "no tables available, pass a table file\n");
+      return 1;
+    }
+    REPORT_HEADER_GEN();
+    // the tables ITAB_*VUN2 are in the order of the IALL_* indices
+    for (int k = 0; k < NALL_VU_N2; k++)
+      REPORT_GEN(SPLINE_TAB_GEN(k, name_VU[k]), k);
+    REPORT_GEN(SPLINE_TAB_GEN(ITAB_UVTN2I, "u(vt,t)"), KIND_UVT_GEN);
+    REPORT_GEN(SPLINE_TAB_GEN(ITAB_UVHN2, "u(vt,h)"), KIND_UVH_GEN);
+    REPORT_BW_HEADER_GEN();
+    for (int kind = 0; kind < NZ_GEN; kind++)
+      REPORT_BW_GEN(
+          name_BW[kind], kind, SBTL_TAB_N2[ITAB_VUPTN2 + kind], NX1_VUPZN2, NX2_VUPZN2);
+    return 0;
+  }
+
+  if (strcmp(argv[1], "tables") == 0)
+  {
+    if (argc != 3)
+      return USAGE_GEN(argv[0]);
+    // forward and initial guess splines from the reference equations, then the backward splines
+    // inverting the new forward splines, all on the grids of the library
+    static std::vector<double> data[NTAB_N2];
+    if (!FIT_FORWARD_GEN(data) ||
+        !FIT_INI_GEN(true,
+                     AXIS_NODES_GEN(x1_UVTN2I, NX1_UVTN2I),
+                     AXIS_NODES_GEN(x2_UVTN2I, NX2_UVTN2I),
+                     data[ITAB_UVTN2I]) ||
+        !FIT_INI_GEN(false,
+                     AXIS_NODES_GEN(x1_UVHN2, NX1_UVHN2),
+                     AXIS_NODES_GEN(x2_UVHN2, NX2_UVHN2),
+                     data[ITAB_UVHN2]))
+      return 1;
+    for (int k = 0; k <= ITAB_UVHN2; k++)
+      USE_GEN(k, data[k]);
+    if (!CHECK_UVT_GEN(SPLINE_TAB_GEN(ITAB_UVTN2I, "u(vt,t)")))
+      return 1;
+    for (int kind = 0; kind < NZ_GEN; kind++)
+    {
+      if (!FIT_BW_GEN(kind, NX1_VUPZN2, NX2_VUPZN2, data[ITAB_VUPTN2 + kind]))
+        return 1;
+      USE_GEN(ITAB_VUPTN2 + kind, data[ITAB_VUPTN2 + kind]);
+    }
+    if (SBTL_TAB_N2_WRITE(argv[2]) != I_OK)
+    {
+      fprintf(stderr, "%s\n", SBTL_TAB_N2_ERROR());
+      return 1;
+    }
+    printf("wrote %s\n", argv[2]);
+    REPORT_HEADER_GEN();
+    for (int k = 0; k < NALL_VU_N2; k++)
+      REPORT_GEN(SPLINE_TAB_GEN(k, name_VU[k]), k);
+    REPORT_GEN(SPLINE_TAB_GEN(ITAB_UVTN2I, "u(vt,t)"), KIND_UVT_GEN);
+    REPORT_GEN(SPLINE_TAB_GEN(ITAB_UVHN2, "u(vt,h)"), KIND_UVH_GEN);
+    REPORT_BW_HEADER_GEN();
+    for (int kind = 0; kind < NZ_GEN; kind++)
+      REPORT_BW_GEN(name_BW[kind], kind, &data[ITAB_VUPTN2 + kind][0], NX1_VUPZN2, NX2_VUPZN2);
+    return 0;
+  }
+
+  // number of nodes of each subdivision of the new grid
+  const bool uvt = strcmp(argv[1], "UVTN2I") == 0, bw = strcmp(argv[1], "VUPZN2") == 0;
+  const int nargs = uvt || bw ? 2 : 3;
+  if ((!uvt && !bw && strcmp(argv[1], "UVHN2") != 0) || argc < 2 + nargs || argc > 3 + nargs)
+    return USAGE_GEN(argv[0]);
+  int nodes[3];
+  for (int k = 0; k < nargs; k++)
+  {
+    nodes[k] = atoi(argv[2 + k]);
+    if (nodes[k] < 3)
+    {
+      fprintf(stderr, "at least 3 nodes are needed per subdivision\n");
+      return 1;
+    }
+  }
+  const std::string dir = argc > 2 + nargs ? argv[2 + nargs] : ".";
+
+  if (bw)
+  {
+    // backward splines inverting the forward splines in use
+    if (SBTL_TAB_N2_READY() != I_OK)
+    {
+      fprintf(stderr, "no tables available\n");
+      return 1;
+    }
+    std::vector<double> tab[NZ_GEN];
+    for (int kind = 0; kind < NZ_GEN; kind++)
+      if (!FIT_BW_GEN(kind, nodes[0], nodes[1], tab[kind]))
+        return 1;
+    if (!WRITE_BW_GEN(dir, nodes[0], nodes[1], tab))
+      return 1;
+    REPORT_BW_HEADER_GEN();
+    for (int kind = 0; kind < NZ_GEN; kind++)
+    {
+      const std::string name = std::string(name_BW[kind]) + " new";
+      REPORT_BW_GEN(name.c_str(), kind, &tab[kind][0], nodes[0], nodes[1]);
+      REPORT_BW_GEN("in use", kind, SBTL_TAB_N2[ITAB_VUPTN2 + kind], NX1_VUPZN2, NX2_VUPZN2);
+    }
+    return 0;
+  }
+
+  // grids of the current initial guess splines with the given numbers of nodes
+  AXIS_GEN ax1, ax2;
+  ax1.log = true;
+  ax2.log = false;
+  if (uvt)
+  {
+    ax1.bound = {1.58387e-3, 771.691};
+    ax1.nodes = {nodes[0]};
+    ax2.bound = {250., 1300.};
+    ax2.nodes = {nodes[1]};
+  }
+  else
+  {
+    ax1.bound = {1.58388e-3, 1.e-2, 771.691};
+    ax1.nodes = {nodes[0], nodes[1]};
+    ax2.bound = {200.048, 1531.29};
+    ax2.nodes = {nodes[2]};
+  }
+  NODES_GEN(ax1);
+  NODES_GEN(ax2);
+
+  // node values from the reference equations
+  std::vector<double> data;
+  if (!FIT_INI_GEN(uvt, ax1, ax2, data))
+    return 1;
+
+  SPLINE_GEN sp;
+  sp.name = "new";
+  sp.ax1 = ax1;
+  sp.ax2 = ax2;
+  sp.data = &data[0];
+  sp.table = NULL;
+  sp.forward = false;
+  // against the forward splines in use, which U_VT_N2 inverts with the guess
+  if (uvt && SBTL_TAB_N2_READY() == I_OK && !CHECK_UVT_GEN(sp))
+    return 1;
+
+  static const OUTPUT_GEN out_UVT = {
+      "U_VT_N2_INI", "UVTN2I", "ITAB_UVTN2I", "U_VT_N2_INI_T_INL", "t", "u(vt,t)"};
+  static const OUTPUT_GEN out_UVH = {
+      "U_VH_N2_INI", "UVHN2", "ITAB_UVHN2", "U_VH_N2_INI_T_INL", "h", "u(vt,h)"};
+  const OUTPUT_GEN & out = uvt ? out_UVT : out_UVH;
+  if (!WRITE_GEN(dir, out, ax1, ax2, data))
+    return 1;
+
+  const int kind = uvt ? KIND_UVT_GEN : KIND_UVH_GEN;
+  REPORT_HEADER_GEN();
+  REPORT_GEN(sp, kind);
+  if (SBTL_TAB_N2_READY() == I_OK)
+    REPORT_GEN(SPLINE_TAB_GEN(uvt ? ITAB_UVTN2I : ITAB_UVHN2, "in use"), kind);
+  return 0;
+}
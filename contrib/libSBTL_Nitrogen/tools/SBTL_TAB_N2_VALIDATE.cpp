@@ -0,0 +1,250 @@
+///////////////////////////////////////////////////////////////////////////
+// LibSBTL_vu_N2 - SBTL library for gaseous nitrogen based on:
+//
+// Span, R., Lemmon, E.W., Jacobsen, R.T, Wagner, W., and Yokozeki, A.:
+//
+//   "A Reference Equation of State for the Thermodynamic Properties of Nitrogen for Temperatures
+//   from 63.151 to 1000 K and Pressures to 2200 MPa," J. Phys. Chem. Ref. Data, 29(6):1361-1433,
+//   2000.
+//
+// Lemmon, E.W. and Jacobsen, R.T.:
+//
+//   "Viscosity and Thermal Conductivity Equations for Nitrogen, Oxygen, Argon, and Air"
+//   Int. J. Thermophys., 25:21-69, 2004.
+//
+// Copyright (C) Idaho National Laboratory.
+// All rights reserved.
+//
+// Disclaimer:
+// The Idaho National Laboratory (INL) uses its best efforts to deliver a high-quality software and
+// to verify that the computed information is correct. However, INL makes no warranties to that
+// effect, and INL shall not be liable for any damage that may result from errors or omissions in
+// the software.
+//
+// Version: 0.9.0
+//
+// SBTL_TAB_N2_VALIDATE - worst-case deviation of the tables in use from the double precision tables
+//
+//   usage: sbtl_n2_validate [<double precision table file> [<relative tolerance>]]
+//
+// Sweeps the range of validity (0.0005 MPa <= p <= 100 MPa, 250 K <= T <= 1300 K). At each point,
+// the (p,T) flash is performed with the tables in use and every forward spline is evaluated with
+// both those and the double precision tables. The flash is checked by evaluating p(v,u) and
+// t(v,u) of its result with the double precision tables. For a library built with
+// SBTL_FLOAT_TABLES, this bounds the error of the float tables; otherwise all deviations are 0.
+// The sweep also finds the largest number of cells by which the initial guess u(vt,t) misses the
+// cell of the root of t(vt,u), which U_VT_N2 corrects only by one cell without a search.
+// Then the backward splines vt(p,z) and u(p,z) are checked against the forward splines in use:
+// in each cell, the residuals |p(vt,u) - p| / p and |z(vt,u) - z| of their result must stay
+// within the residual bounds of the cell, on which TOL_BACKWARD_N2 relies. The backward splines
+// are generated from forward splines fitted to the reference equations (sbtl_n2_gen), so this
+// shows that the bounds also hold for the forward splines of the library.
+// Returns 1 if a relative deviation exceeds the tolerance (default 1e-5), the guess is more than
+// one cell off or a residual exceeds its bound.
+//
+///////////////////////////////////////////////////////////////////////////
+//
+#include "math.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "SBTL_N2.h"
+#include "SBTL_call_conv.h"
+#include "SBTL_TAB_N2.h"
+#include "U_VT_N2_INI.h"
+#include "VU_N2.h"
+#include "VU_PZ_N2_TAB.h"
+//
+SBTLAPI int __stdcall PT_FLASH_N2(double p, double t, double & v, double & vt, double & u) throw();
+SBTLAPI double __stdcall Z_VU_N2_T(int iall, double vt, double u) throw();
+SBTLAPI int __stdcall VU_PT_N2(
+    double p, double t, double & vt, double & u, double & df_p, double & df_t) throw();
+SBTLAPI int __stdcall VU_PH_N2(
+    double p, double h, double & vt, double & u, double & df_p, double & df_h) throw();
+SBTLAPI int __stdcall VU_PS_N2(
+    double p, double s, double & vt, double & u, double & df_p, double & df_s) throw();
+//
+// number of pressures and temperatures of the sweep
+#define NP_VALIDATE 500
+#define NT_VALIDATE 500
+//
+// deviations of the forward splines, the (p,T) flash result in p and in t
+#define NDEV_VALIDATE (NALL_VU_N2 + 2)
+static const char * name_VALIDATE[NDEV_VALIDATE] = {
+    "p(v,u)", "t(v,u)", "s(v,u)", "w(v,u)", "cp(v,u)", "cv(v,u)", "eta(v,u)", "lambda(v,u)",
+    "p of (p,T) flash", "t of (p,T) flash"};
+//
+// points per cell and direction of the check of the backward splines
+#define NS_BW_VALIDATE 4
+//
+struct DEV_VALIDATE
+{
+  double abs, rel, p, t;
+};
+//
+static void
+UPDATE_VALIDATE(DEV_VALIDATE & dev, double z, double z_ref, double p, double t)
+{
+  const double abs_dev = fabs(z - z_ref);
+  const double rel_dev = z_ref != 0. ? abs_dev / fabs(z_ref) : abs_dev;
+  if (abs_dev > dev.abs)
+    dev.abs = abs_dev;
+  if (rel_dev > dev.rel)
+  {
+    dev.rel = rel_dev;
+    dev.p = p;
+    dev.t = t;
+  }
+}
+//
+// largest ratio of the residuals in p and z of the backward splines 'itab' to the residual bounds
+// of their cells, sampled at NS_BW_VALIDATE x NS_BW_VALIDATE points of each cell within the range
+// of validity, with (p,z) of the largest ratio; false if the backward splines fail at a point
+static bool
+CHECK_BW_VALIDATE(int itab, double & ratio, double & p_max, double & z_max)
+{
+  typedef int(__stdcall * BW_FUN)(double, double, double &, double &, double &, double &);
+  static const BW_FUN bw_fun[3] = {VU_PT_N2, VU_PH_N2, VU_PS_N2};
+  const int kind = itab - ITAB_VUPTN2;
+  const SBTL_COEF_N2 * data = SBTL_TAB_N2[itab];
+  const double h1 = (X1_MAX_VUPZN2 - X1_MIN_VUPZN2) / (NX1_VUPZN2 - 1), h2 = 1. / (NX2_VUPZN2 - 1);
+
+  ratio = 0.;
+  for (int i = 0; i < NX1_VUPZN2; i++)
+    for (int j = 0; j < NX2_VUPZN2; j++)
+      for (int k1 = 0; k1 < NS_BW_VALIDATE; k1++)
+        for (int k2 = 0; k2 < NS_BW_VALIDATE; k2++)
+        {
+          // points of the cell from the knot below to the knot above the node, clipped to the grid
+          const double dx1 = h1 * ((k1 + 0.5) / NS_BW_VALIDATE - 0.5);
+          const double x2 = h2 * (j + (k2 + 0.5) / NS_BW_VALIDATE - 0.5);
+          const double x1 = i * h1 + dx1;
+          if (x1 < 0. || x1 > X1_MAX_VUPZN2 - X1_MIN_VUPZN2 || x2 < 0. || x2 > 1.)
+            continue;
+          const double p = exp(X1_MIN_VUPZN2 + x1);
+          const SBTL_COEF_N2 * b = &data[NCOEF_VUPZN2 * NCELL_VUPZN2 + NBOUND_VUPZN2 * i];
+          const double z = itab == ITAB_VUPTN2
+                               ? TMIN_N2 + x2 * (TMAX_N2 - TMIN_N2)
+                               : b[0] + dx1 * (b[1] + dx1 * b[2]) +
+                                     x2 / (b[3] + dx1 * (b[4] + dx1 * b[5]));
+          double vt, u, df_p, df_z;
+          if (bw_fun[kind](p, z, vt, u, df_p, df_z) != I_OK)
+            return false;
+
+          // residuals with the forward splines in use
+          const double p_fw = Z_VU_N2_T(IALL_P, vt, u);
+          const double z_fw = itab == ITAB_VUPTN2   ? Z_VU_N2_T(IALL_T, vt, u)
+                              : itab == ITAB_VUPHN2 ? u + p_fw * exp(vt) * 1.e3
+                                                    : Z_VU_N2_T(IALL_S, vt, u);
+          const double r = fmax(fabs(p_fw - p) / p / df_p, fabs(z_fw - z) / df_z);
+          if (r > ratio)
+          {
+            ratio = r;
+            p_max = p;
+            z_max = z;
+          }
+        }
+  return true;
+}
+//
+int
+main(int argc, char ** argv)
+{
+  if (argc > 3)
+  {
+    fprintf(stderr, "usage: %s [<table file> [<relative tolerance>]]\n", argv[0]);
+    return 1;
+  }
+  if (argc > 1 && SBTL_TAB_N2_LOAD(argv[1]) != I_OK)
+  {
+    fprintf(stderr, "%s\n", SBTL_TAB_N2_ERROR());
+    return 1;
+  }
+  const double tol = argc > 2 ? atof(argv[2]) : 1e-5;
+  for (int k = 0; k < NTAB_N2; k++)
+    if (!SBTL_TAB_N2[k] || !SBTL_TAB_N2_DOUBLE[k])
+    {
+      fprintf(stderr, "double precision tables are not available, pass a double table file\n");
+      return 1;
+    }
+
+  DEV_VALIDATE dev[NDEV_VALIDATE] = {};
+  int n_fail = 0, uvt_off = 0;
+  for (int ip = 0; ip < NP_VALIDATE; ip++)
+  {
+    // logarithmic in p
+    const double p = 0.0005 * pow(100. / 0.0005, ip / (NP_VALIDATE - 1.));
+    for (int it = 0; it < NT_VALIDATE; it++)
+    {
+      const double t = 250. + (1300. - 250.) * it / (NT_VALIDATE - 1.);
+      double v, vt, u;
+      if (PT_FLASH_N2(p, t, v, vt, u) != I_OK)
+      {
+        n_fail++;
+        continue;
+      }
+
+      unsigned int i, j;
+      double dx1, dx2;
+      IJ_VU_N2_T_INL(vt, u, i, j, dx1, dx2);
+      // the tables ITAB_*VUN2 are in the order of the IALL_* indices
+      double z_ref[NALL_VU_N2];
+      for (int k = 0; k < NALL_VU_N2; k++)
+      {
+        z_ref[k] = SPLINE_VU_N2(CELL_VU_N2(SBTL_TAB_N2_DOUBLE[k], i, j), dx1, dx2);
+        const double z = SPLINE_VU_N2(CELL_VU_N2(SBTL_TAB_N2[k], i, j), dx1, dx2);
+        UPDATE_VALIDATE(dev[k], z, z_ref[k], p, t);
+      }
+      UPDATE_VALIDATE(dev[NALL_VU_N2], p, z_ref[IALL_P], p, t);
+      UPDATE_VALIDATE(dev[NALL_VU_N2 + 1], t, z_ref[IALL_T], p, t);
+
+      // cell of the initial guess of U_VT_N2
+      unsigned int i_guess, j_guess;
+      IJ_VU_N2_T_INL(vt, U_VT_N2_INI_T_INL(vt, t), i_guess, j_guess, dx1, dx2);
+      if (abs((int)j_guess - (int)j) > uvt_off)
+        uvt_off = abs((int)j_guess - (int)j);
+    }
+  }
+
+  printf("coefficients: %s\n", sizeof(SBTL_COEF_N2) == sizeof(double) ? "double" : "float");
+  printf("%-18s %12s %12s %12s %10s\n", "", "max abs", "max rel", "at p (MPa)", "t (K)");
+  bool ok = n_fail == 0;
+  for (int k = 0; k < NDEV_VALIDATE; k++)
+  {
+    printf("%-18s %12.4e %12.4e %12.6g %10.6g\n",
+           name_VALIDATE[k],
+           dev[k].abs,
+           dev[k].rel,
+           dev[k].p,
+           dev[k].t);
+    if (dev[k].rel > tol)
+      ok = false;
+  }
+  if (n_fail > 0)
+    printf("%d of %d (p,T) flashes failed\n", n_fail, NP_VALIDATE * NT_VALIDATE);
+  printf("initial guess u(vt,t): up to %d cells off the root of t(vt,u)\n", uvt_off);
+  if (uvt_off > 1)
+    ok = false;
+
+  // residuals of the backward splines relative to the bounds of their cells
+  static const char * name_BW[3] = {"vu(p,t)", "vu(p,h)", "vu(p,s)"};
+  printf("%-18s %12s %12s %12s\n", "", "max residual", "at p (MPa)", "z");
+  printf("%-18s %12s\n", "", "/ bound");
+  for (int itab = ITAB_VUPTN2; itab <= ITAB_VUPSN2; itab++)
+  {
+    double ratio, p = 0., z = 0.;
+    if (!CHECK_BW_VALIDATE(itab, ratio, p, z))
+    {
+      printf("%-18s backward splines failed within the range of validity\n",
+             name_BW[itab - ITAB_VUPTN2]);
+      ok = false;
+      continue;
+    }
+    printf("%-18s %12.4f %12.6g %12.6g\n", name_BW[itab - ITAB_VUPTN2], ratio, p, z);
+    if (ratio > 1.)
+      ok = false;
+  }
+  printf("%s (relative tolerance %g, residuals within the bounds)\n",
+         ok ? "PASSED" : "FAILED",
+         tol);
+  return ok ? 0 : 1;
+}
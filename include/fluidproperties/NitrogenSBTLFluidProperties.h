@@ -11,11 +11,12 @@
 
 #include "SinglePhaseFluidProperties.h"
 #include "NaNInterface.h"
+#include "contrib/libSBTL_Nitrogen/SBTL_N2.h"
 
 /**
  * Properties of nitrogen according to Span et al. computed with the SBTL method
  *
- * Range of validity:
+ * Range of validity (PMIN_N2 to TMAX_N2 of SBTL_N2.h):
  *   0.0005 MPa <= p <= 100 MPa
  *   250 K <= T <= 1300 K
  *
@@ -57,6 +58,8 @@ public:
   virtual void s_from_v_e(Real v, Real e, Real & s, Real & ds_dv, Real & ds_de) const override;
   virtual Real s_from_h_p(Real h, Real p) const override;
   virtual void s_from_h_p(Real h, Real p, Real & s, Real & ds_dh, Real & ds_dp) const override;
+  virtual Real T_from_p_h(Real p, Real h) const override;
+  virtual void T_from_p_h(Real p, Real h, Real & T, Real & dT_dp, Real & dT_dh) const override;
   virtual Real rho_from_p_s(Real p, Real s) const override;
   virtual void
   rho_from_p_s(Real p, Real s, Real & rho, Real & drho_dp, Real & drho_ds) const override;
@@ -97,9 +100,479 @@ public:
   beta_from_p_T(Real p, Real T, Real & beta, Real & dbeta_dp, Real & dbeta_dT) const override;
   virtual Real molarMass() const override;
 
+  /**
+   * AD versions: the derivatives of the dual numbers are taken directly from the derivatives of
+   * the splines (a single spline cell per property, after a single flash for the (p,T) ones)
+   */
+  ///@{
+  virtual ADReal p_from_v_e(const ADReal & v, const ADReal & e) const override;
+  virtual ADReal T_from_v_e(const ADReal & v, const ADReal & e) const override;
+  virtual ADReal c_from_v_e(const ADReal & v, const ADReal & e) const override;
+  virtual ADReal cp_from_v_e(const ADReal & v, const ADReal & e) const override;
+  virtual ADReal cv_from_v_e(const ADReal & v, const ADReal & e) const override;
+  virtual ADReal mu_from_v_e(const ADReal & v, const ADReal & e) const override;
+  virtual ADReal k_from_v_e(const ADReal & v, const ADReal & e) const override;
+  virtual ADReal s_from_v_e(const ADReal & v, const ADReal & e) const override;
+  virtual ADReal rho_from_p_T(const ADReal & p, const ADReal & T) const override;
+  virtual ADReal h_from_p_T(const ADReal & p, const ADReal & T) const override;
+  virtual ADReal cp_from_p_T(const ADReal & p, const ADReal & T) const override;
+  virtual ADReal cv_from_p_T(const ADReal & p, const ADReal & T) const override;
+  virtual ADReal mu_from_p_T(const ADReal & p, const ADReal & T) const override;
+  virtual ADReal k_from_p_T(const ADReal & p, const ADReal & T) const override;
+  virtual ADReal T_from_p_h(const ADReal & p, const ADReal & h) const override;
+  ///@}
+
+  /**
+   * Paired conversions: each pair comes from a single cell search or flash instead of one per
+   * property. The initial guesses p0 and T0 are not needed by the SBTL flashes and are ignored. If
+   * a flash fails, the outputs are NaN and conversion_succeeded is false; p_T_from_v_e, which needs
+   * no flash, reports whether (p,T) is in the range of validity instead.
+   *
+   * SinglePhaseFluidProperties declares these as non-virtual templates, which cannot be
+   * overridden: these overloads hide them and are only reached through a reference to
+   * NitrogenSBTLFluidProperties (e.g. getUserObject<NitrogenSBTLFluidProperties>). Through a
+   * reference to the base class, the templates run their generic Newton iteration on the
+   * virtual single-property methods of this class, which is correct but takes several flashes
+   * per call instead of one.
+   */
+  ///@{
+  void p_T_from_v_e(const Real & v,
+                    const Real & e,
+                    Real p0,
+                    Real T0,
+                    Real & p,
+                    Real & T,
+                    bool & conversion_succeeded) const;
+  void p_T_from_v_e(const ADReal & v,
+                    const ADReal & e,
+                    Real p0,
+                    Real T0,
+                    ADReal & p,
+                    ADReal & T,
+                    bool & conversion_succeeded) const;
+  void p_T_from_v_h(const Real & v,
+                    const Real & h,
+                    Real p0,
+                    Real T0,
+                    Real & p,
+                    Real & T,
+                    bool & conversion_succeeded) const;
+  void p_T_from_v_h(const ADReal & v,
+                    const ADReal & h,
+                    Real p0,
+                    Real T0,
+                    ADReal & p,
+                    ADReal & T,
+                    bool & conversion_succeeded) const;
+  void p_T_from_h_s(const Real & h,
+                    const Real & s,
+                    Real p0,
+                    Real T0,
+                    Real & p,
+                    Real & T,
+                    bool & conversion_succeeded) const;
+  void p_T_from_h_s(const ADReal & h,
+                    const ADReal & s,
+                    Real p0,
+                    Real T0,
+                    ADReal & p,
+                    ADReal & T,
+                    bool & conversion_succeeded) const;
+  void v_e_from_p_T(const Real & p, const Real & T, Real & v, Real & e) const;
+  void v_e_from_p_T(const Real & p,
+                    const Real & T,
+                    Real & v,
+                    Real & dv_dp,
+                    Real & dv_dT,
+                    Real & e,
+                    Real & de_dp,
+                    Real & de_dT) const;
+  void v_e_from_p_T(const ADReal & p, const ADReal & T, ADReal & v, ADReal & e) const;
+  ///@}
+
+  /**
+   * Batched evaluations from specific volume and specific internal energy
+   *
+   * The input arrays must have the same length; the output array is resized to it. All points are
+   * evaluated in a single loop of the corresponding libSBTL array function.
+   *
+   * @param[in] v   specific volumes (m^3/kg)
+   * @param[in] e   specific internal energies (J/kg)
+   * @param[out] p  the property at each point (SI units)
+   */
+  ///@{
+  void
+  p_from_v_e(const std::vector<Real> & v, const std::vector<Real> & e, std::vector<Real> & p) const;
+  void
+  T_from_v_e(const std::vector<Real> & v, const std::vector<Real> & e, std::vector<Real> & T) const;
+  void
+  c_from_v_e(const std::vector<Real> & v, const std::vector<Real> & e, std::vector<Real> & c) const;
+  void cp_from_v_e(const std::vector<Real> & v,
+                   const std::vector<Real> & e,
+                   std::vector<Real> & cp) const;
+  void cv_from_v_e(const std::vector<Real> & v,
+                   const std::vector<Real> & e,
+                   std::vector<Real> & cv) const;
+  void mu_from_v_e(const std::vector<Real> & v,
+                   const std::vector<Real> & e,
+                   std::vector<Real> & mu) const;
+  void
+  k_from_v_e(const std::vector<Real> & v, const std::vector<Real> & e, std::vector<Real> & k) const;
+  void
+  s_from_v_e(const std::vector<Real> & v, const std::vector<Real> & e, std::vector<Real> & s) const;
+  void
+  g_from_v_e(const std::vector<Real> & v, const std::vector<Real> & e, std::vector<Real> & g) const;
+  ///@}
+
+  /// Properties at arrays of state points (SI units)
+  struct BatchState
+  {
+    std::vector<Real> p, T, c, cp, cv, mu, k, s;
+  };
+
+  /**
+   * The properties of BatchState from arrays of specific volume and specific internal energy
+   *
+   * The state points are sorted by spline cell once for all properties and each property is then
+   * evaluated cell by cell, loading the coefficients of a cell once however the points are
+   * ordered. For large batches this is cheaper than the vector overloads above one by one; for a
+   * single property or a few points it is not.
+   *
+   * @param[in] v       specific volumes (m^3/kg)
+   * @param[in] e       specific internal energies (J/kg)
+   * @param[out] state  the properties at each point, resized to the number of points
+   */
+  void props_from_v_e(const std::vector<Real> & v,
+                      const std::vector<Real> & e,
+                      BatchState & state) const;
+
+#pragma GCC diagnostic pop
+
+  /// Properties and their derivatives w.r.t. (v,e) at a single state point (SI units)
+  struct State
+  {
+    Real p, dp_dv, dp_de;
+    Real T, dT_dv, dT_de;
+    Real c, dc_dv, dc_de;
+    Real cp, dcp_dv, dcp_de;
+    Real cv, dcv_dv, dcv_de;
+    Real mu, dmu_dv, dmu_de;
+    Real k, dk_dv, dk_de;
+    Real s, ds_dv, ds_de;
+    Real h, dh_dv, dh_de;
+    Real g, dg_dv, dg_de;
+  };
+
+  /**
+   * All properties and their derivatives from specific volume and specific internal energy
+   *
+   * The transformed volume and the spline cell are computed once and shared by all properties,
+   * which is considerably cheaper than calling the individual *_from_v_e methods.
+   *
+   * @param[in] v       specific volume (m^3/kg)
+   * @param[in] e       specific internal energy (J/kg)
+   * @param[out] state  the properties and their derivatives
+   */
+  void all_from_v_e(Real v, Real e, State & state) const;
+
+  /// Specific volume together with its logarithm, the coordinate of the splines
+  struct PreparedVolume
+  {
+    /// Specific volume (m^3/kg)
+    Real v;
+    /// Transformed volume log(v)
+    Real vt;
+  };
+
+  /**
+   * Prepares a specific volume for the methods below, which take the logarithm from it instead of
+   * computing it for every property
+   *
+   * @param[in] v   specific volume (m^3/kg)
+   */
+  PreparedVolume prepareVolume(Real v) const { return {v, std::log(v)}; }
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Woverloaded-virtual"
+
+  /**
+   * Properties (and their derivatives) from a prepared specific volume and the specific internal
+   * energy (J/kg), same as the corresponding methods taking the specific volume
+   */
+  ///@{
+  Real p_from_v_e(const PreparedVolume & v, Real e) const;
+  void p_from_v_e(const PreparedVolume & v, Real e, Real & p, Real & dp_dv, Real & dp_de) const;
+  Real T_from_v_e(const PreparedVolume & v, Real e) const;
+  void T_from_v_e(const PreparedVolume & v, Real e, Real & T, Real & dT_dv, Real & dT_de) const;
+  Real cp_from_v_e(const PreparedVolume & v, Real e) const;
+  void
+  cp_from_v_e(const PreparedVolume & v, Real e, Real & cp, Real & dcp_dv, Real & dcp_de) const;
+  Real cv_from_v_e(const PreparedVolume & v, Real e) const;
+  void
+  cv_from_v_e(const PreparedVolume & v, Real e, Real & cv, Real & dcv_dv, Real & dcv_de) const;
+  Real mu_from_v_e(const PreparedVolume & v, Real e) const;
+  void
+  mu_from_v_e(const PreparedVolume & v, Real e, Real & mu, Real & dmu_dv, Real & dmu_de) const;
+  Real k_from_v_e(const PreparedVolume & v, Real e) const;
+  void k_from_v_e(const PreparedVolume & v, Real e, Real & k, Real & dk_dv, Real & dk_de) const;
+  Real s_from_v_e(const PreparedVolume & v, Real e) const;
+  void s_from_v_e(const PreparedVolume & v, Real e, Real & s, Real & ds_dv, Real & ds_de) const;
+  void all_from_v_e(const PreparedVolume & v, Real e, State & state) const;
+  Real e_from_v_h(const PreparedVolume & v, Real h) const;
+  ///@}
+
+  /**
+   * all_from_v_e with a hint for the spline cell
+   *
+   * The cell found for the previous state point is checked first, which skips the cell search
+   * when the state point of e.g. a quadrature point changes little between time steps.
+   *
+   * @param[in] v         prepared specific volume
+   * @param[in] e         specific internal energy (J/kg)
+   * @param[out] state    the properties and their derivatives
+   * @param[in,out] cell  spline cell of the previous call (CELL_NONE_N2 before the first call)
+   */
+  void all_from_v_e(const PreparedVolume & v, Real e, State & state, unsigned int & cell) const;
+
 #pragma GCC diagnostic pop
 
+  /// Properties and their derivatives w.r.t. (p,T) at a single state point (SI units)
+  struct StatePT
+  {
+    Real rho, drho_dp, drho_dT;
+    Real e, de_dp, de_dT;
+    Real h, dh_dp, dh_dT;
+    Real s, ds_dp, ds_dT;
+    Real c, dc_dp, dc_dT;
+    Real cp, dcp_dp, dcp_dT;
+    Real cv, dcv_dp, dcv_dT;
+    Real mu, dmu_dp, dmu_dT;
+    Real k, dk_dp, dk_dT;
+  };
+
+  /**
+   * All properties and their derivatives from pressure and temperature
+   *
+   * A single (p,T) flash is performed and all properties are evaluated from the shared spline
+   * cell, instead of one flash per *_from_p_T call. If the flash fails, all members are NaN.
+   *
+   * @param[in] p       pressure (Pa)
+   * @param[in] T       temperature (K)
+   * @param[out] state  the properties and their derivatives
+   */
+  void props_from_p_T(Real p, Real T, StatePT & state) const;
+
+  /// Density and its derivatives w.r.t. (p,h) from a single (p,h) flash
+  ///@{
+  Real rho_from_p_h(Real p, Real h) const;
+  void rho_from_p_h(Real p, Real h, Real & rho, Real & drho_dp, Real & drho_dh) const;
+  ///@}
+
+  /// Properties and their derivatives w.r.t. (p,h) at a single state point (SI units)
+  struct StatePH
+  {
+    Real rho, drho_dp, drho_dh;
+    Real T, dT_dp, dT_dh;
+    Real e, de_dp, de_dh;
+    Real s, ds_dp, ds_dh;
+    Real c, dc_dp, dc_dh;
+    Real cp, dcp_dp, dcp_dh;
+    Real cv, dcv_dp, dcv_dh;
+    Real mu, dmu_dp, dmu_dh;
+    Real k, dk_dp, dk_dh;
+  };
+
+  /**
+   * All properties and their derivatives from pressure and specific enthalpy
+   *
+   * A single (p,h) flash is performed and all properties are evaluated from the shared spline
+   * cell, for solvers with (p,h) as primary variables. If the flash fails, all members are NaN.
+   *
+   * @param[in] p       pressure (Pa)
+   * @param[in] h       specific enthalpy (J/kg)
+   * @param[out] state  the properties and their derivatives
+   */
+  void props_from_p_h(Real p, Real h, StatePH & state) const;
+
+  /**
+   * Fraction of the (p,T), (p,h), (p,s) and (h,s) flashes of this object that were exact repeats
+   * of the previous state point and returned without any Newton iteration
+   */
+  Real flashCacheHitRate() const;
+
+  /**
+   * Fraction of the (p,T), (p,h), (p,s) and (h,s) flashes of this object whose Newton iterations
+   * started from the previous state point
+   */
+  Real flashWarmStartRate() const;
+
+  /**
+   * Switches back from the node-wide copy of the coefficient tables ('table_sharing') to the tables
+   * of the process and frees the MPI shared memory window; collective over the processes of the
+   * node. Runs when MPI is finalized at the latest, but may be called earlier, e.g. by tests.
+   */
+  static void unshareTables();
+
+  /// Flashes covered by the 'instrument_flashes' statistics
+  enum FlashType
+  {
+    FLASH_PT,
+    FLASH_PH,
+    FLASH_PS,
+    FLASH_HS,
+    NUM_FLASH_TYPES
+  };
+
+  /// Bins of the Newton iteration histogram, the last one also counts all flashes with more
+  static const unsigned int NUM_ITERATION_BINS = 13;
+
+  /// Statistics of one flash type of this object (one object per thread)
+  struct FlashStatistics
+  {
+    /// Number of flashes
+    unsigned long calls = 0;
+    /// Number of flashes that did not converge
+    unsigned long failures = 0;
+    /// Number of flashes with inputs outside of the range of validity (for (h,s), outside of the
+    /// extremes of h and s in it)
+    unsigned long out_of_range = 0;
+    /// Time spent in the flashes (s)
+    Real time = 0.;
+    /// Number of flashes by the Newton iterations they needed
+    unsigned long iterations[NUM_ITERATION_BINS] = {};
+  };
+
+  /// Whether the flash statistics are collected ('instrument_flashes')
+  bool instrumentFlashes() const { return _instrument_flashes; }
+
+  /// Flash statistics of this object, all zero unless 'instrument_flashes' is set
+  const FlashStatistics & flashStatistics(FlashType type) const { return _flash_stats[type]; }
+
 protected:
+  /// Signature of the libSBTL array functions
+  typedef void (*SBTLArrayFunction)(const double *, const double *, double *, std::size_t);
+
+  /**
+   * Evaluates a libSBTL array function for arrays of (v,e)
+   *
+   * @param[in] fn      the libSBTL array function
+   * @param[in] v       specific volumes (m^3/kg)
+   * @param[in] e       specific internal energies (J/kg)
+   * @param[out] prop   the property at each point
+   * @param[in] scale   conversion factor from libSBTL units to SI units
+   */
+  void batchFromVE(SBTLArrayFunction fn,
+                   const std::vector<Real> & v,
+                   const std::vector<Real> & e,
+                   std::vector<Real> & prop,
+                   Real scale) const;
+
+  /**
+   * Evaluates a property with derivatives for a prepared specific volume
+   *
+   * @param[in] iall    the property (IALL_* index of libSBTL)
+   * @param[in] v       prepared specific volume
+   * @param[in] e       specific internal energy (J/kg)
+   * @param[in] scale   conversion factor from libSBTL units to SI units
+   * @param[out] z      the property (SI units)
+   * @param[out] dz_dv  derivative of the property w.r.t. specific volume
+   * @param[out] dz_de  derivative of the property w.r.t. specific internal energy
+   */
+  void fromPreparedVE(int iall,
+                      const PreparedVolume & v,
+                      Real e,
+                      Real scale,
+                      Real & z,
+                      Real & dz_dv,
+                      Real & dz_de) const;
+
+  /**
+   * Evaluates a property with derivatives for a dual (v,e)
+   *
+   * @param[in] iall    the property (IALL_* index of libSBTL)
+   * @param[in] v       specific volume (m^3/kg)
+   * @param[in] e       specific internal energy (J/kg)
+   * @param[in] scale   conversion factor from libSBTL units to SI units
+   */
+  ADReal adFromVE(int iall, const ADReal & v, const ADReal & e, Real scale) const;
+
+  /**
+   * Property of DIFF_ALL_VU_N2 and its derivatives w.r.t. (p,T) after a (p,T) flash (NaN if the
+   * flash fails)
+   *
+   * @param[in] k       the property (IALL_*)
+   * @param[in] scale   conversion factor from libSBTL units to SI units
+   * @param[in] p       pressure (Pa)
+   * @param[in] T       temperature (K)
+   * @param[out] x      the property (SI units)
+   * @param[out] dx_dp  derivative of the property w.r.t. pressure
+   * @param[out] dx_dT  derivative of the property w.r.t. temperature
+   */
+  void propFromPT(
+      unsigned int k, Real scale, Real p, Real T, Real & x, Real & dx_dp, Real & dx_dT) const;
+
+  /**
+   * Pressure and temperature and their derivatives w.r.t. (v,e) from a single cell search
+   *
+   * @param[in] v       specific volume (m^3/kg)
+   * @param[in] vt      transformed specific volume log(v)
+   * @param[in] e       specific internal energy (J/kg)
+   */
+  void pTFromVE(Real v,
+                Real vt,
+                Real e,
+                Real & p,
+                Real & dp_dv,
+                Real & dp_de,
+                Real & T,
+                Real & dT_dv,
+                Real & dT_de) const;
+
+  /// Dual number of a property from its value and its derivatives w.r.t. the dual numbers (a,b)
+  static ADReal dual(Real x, Real dx_da, Real dx_db, const ADReal & a, const ADReal & b);
+
+  /**
+   * Flashes in libSBTL units (MPa, kJ/kg), using the last state point of this object if
+   * 'use_flash_cache' is set and the convergence criteria of 'flash_tolerance'. Same arguments and
+   * return values as PT_FLASH_N2, PT_FLASH_DERIV_N2, PH_FLASH_N2, PS_FLASH_N2 and HS_FLASH_N2.
+   */
+  ///@{
+  int flashPT(double p, double T, double & v, double & vt, double & e) const;
+  int flashPTDeriv(double p,
+                   double T,
+                   double & v,
+                   double & vt,
+                   double & dv_dp,
+                   double & dv_dT,
+                   double & dp_dT_v,
+                   double & e,
+                   double & de_dp,
+                   double & de_dT,
+                   double & dp_dT_e) const;
+  int flashPH(double p, double h, double & v, double & vt, double & e) const;
+  int flashPS(double p, double s, double & v, double & vt, double & e) const;
+  int flashHS(double h, double s, double & v, double & vt, double & e) const;
+  ///@}
+
+  /// Signature of the libSBTL flash functions with a state struct
+  typedef int (*SBTLFlashFunction)(double, double, double &, double &, double &, STR_vu_SBTL_N2 &);
+
+  /// Flash through 'fn' from the auxiliary splines, with the convergence criteria of this object
+  int uncachedFlash(
+      SBTLFlashFunction fn, double x, double y, double & v, double & vt, double & e) const;
+
+  /// Flash through 'fn' that updates the statistics of 'type' ('instrument_flashes')
+  int instrumentedFlash(SBTLFlashFunction fn,
+                        FlashType type,
+                        double x,
+                        double y,
+                        double & v,
+                        double & vt,
+                        double & e) const;
+
+  /// Moves the coefficient tables to memory shared by the processes of a node ('table_sharing')
+  void shareTables();
+
   /// Conversion factor from Pa to MPa
   const Real _to_MPa;
   /// Conversion factor from MPa to Pa
@@ -109,6 +582,21 @@ protected:
   /// Conversion factor from kJ to J
   const Real _to_J;
 
+  /// Whether the flashes reuse the last state point
+  const bool _use_flash_cache;
+  /// Last state point and convergence criteria of the flashes (fluid properties objects are
+  /// threaded, so this is per thread)
+  mutable STR_vu_SBTL_N2 _flash_state;
+  /// Whether the flash statistics are collected
+  const bool _instrument_flashes;
+  /// Flash statistics by flash type
+  mutable FlashStatistics _flash_stats[NUM_FLASH_TYPES];
+
+  /// Internal energies in kJ/kg passed to the libSBTL array functions
+  mutable std::vector<double> _e_kJ;
+  /// Workspace of the cell-binned libSBTL array function in props_from_v_e
+  mutable std::vector<double> _nb_work;
+
 public:
   static InputParameters validParams();
 };
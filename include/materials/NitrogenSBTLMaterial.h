@@ -0,0 +1,63 @@
+//* This file is part of nitrogen
+//* https://github.com/idaholab/nitrogen
+//*
+//* All rights reserved, see NOTICE.txt for full restrictions
+//* https://github.com/idaholab/nitrogen/blob/master/NOTICE.txt
+//*
+//* Licensed under LGPL 2.1, please see LICENSE for details
+//* https://www.gnu.org/licenses/lgpl-2.1.html
+
+#pragma once
+
+#include "Material.h"
+
+class NitrogenSBTLFluidProperties;
+
+/**
+ * Fluid properties of nitrogen from specific volume and specific internal energy computed with
+ * NitrogenSBTLFluidProperties::all_from_v_e
+ *
+ * The spline cell of each quadrature point is kept as a stateful property and passed as the hint
+ * of the next evaluation, so the cell search is skipped while the state changes little.
+ */
+class NitrogenSBTLMaterial : public Material
+{
+public:
+  static InputParameters validParams();
+
+  NitrogenSBTLMaterial(const InputParameters & parameters);
+
+protected:
+  virtual void initQpStatefulProperties() override;
+  virtual void computeQpProperties() override;
+
+  /// Specific volume (m^3/kg)
+  const VariableValue & _v;
+  /// Specific internal energy (J/kg)
+  const VariableValue & _e;
+
+  /// Pressure (Pa)
+  MaterialProperty<Real> & _p;
+  /// Temperature (K)
+  MaterialProperty<Real> & _T;
+  /// Speed of sound (m/s)
+  MaterialProperty<Real> & _c;
+  /// Isobaric specific heat capacity (J/(kg K))
+  MaterialProperty<Real> & _cp;
+  /// Isochoric specific heat capacity (J/(kg K))
+  MaterialProperty<Real> & _cv;
+  /// Dynamic viscosity (Pa s)
+  MaterialProperty<Real> & _mu;
+  /// Thermal conductivity (W/(m K))
+  MaterialProperty<Real> & _k;
+  /// Specific entropy (J/(kg K))
+  MaterialProperty<Real> & _s;
+
+  /// Spline cell of the current evaluation
+  MaterialProperty<unsigned int> & _cell;
+  /// Spline cell of the previous time step, the hint of the current evaluation
+  const MaterialProperty<unsigned int> & _cell_old;
+
+  /// Fluid properties
+  const NitrogenSBTLFluidProperties & _fp;
+};
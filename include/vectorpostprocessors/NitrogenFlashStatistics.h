@@ -0,0 +1,45 @@
+//* This file is part of nitrogen
+//* https://github.com/idaholab/nitrogen
+//*
+//* All rights reserved, see NOTICE.txt for full restrictions
+//* https://github.com/idaholab/nitrogen/blob/master/NOTICE.txt
+//*
+//* Licensed under LGPL 2.1, please see LICENSE for details
+//* https://www.gnu.org/licenses/lgpl-2.1.html
+
+#pragma once
+
+#include "GeneralVectorPostprocessor.h"
+
+/**
+ * Flash statistics of a NitrogenSBTLFluidProperties object with 'instrument_flashes', summed over
+ * all threads and processes
+ *
+ * There is one row per flash type, in the order (p,T), (p,h), (p,s) and (h,s).
+ */
+class NitrogenFlashStatistics : public GeneralVectorPostprocessor
+{
+public:
+  static InputParameters validParams();
+
+  NitrogenFlashStatistics(const InputParameters & parameters);
+
+  virtual void initialize() override;
+  virtual void execute() override;
+  virtual void finalize() override;
+
+protected:
+  /// Name of the fluid properties object
+  const UserObjectName & _fp_name;
+
+  /// Number of flashes
+  VectorPostprocessorValue & _calls;
+  /// Number of flashes that did not converge
+  VectorPostprocessorValue & _failures;
+  /// Number of state points outside of the range of validity
+  VectorPostprocessorValue & _out_of_range;
+  /// Time spent in the flashes (s)
+  VectorPostprocessorValue & _time;
+  /// Number of flashes by Newton iterations
+  std::vector<VectorPostprocessorValue *> _iterations;
+};
@@ -4,8 +4,12 @@
 LIBSBTL_NITROGEN_DIR       := $(NITROGEN_DIR)/contrib/libSBTL_Nitrogen
 
 LIBSBTL_NITROGEN_srcfiles  :=
+LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/ALL_VU_N2.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/CP_VU_N2.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/CV_VU_N2.cpp
+LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/DIFF_CP_VU_N2.cpp
+LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/DIFF_CV_VU_N2.cpp
+LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/DIFF_ETA_VU_N2.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/ETA_VU_N2.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/G_VU_N2.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/HS_FLASH_N2.cpp
@@ -13,16 +17,23 @@ LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/HV_FLASH_N2.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/LAMBDA_VU_N2.cpp
 #LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/LibSBTL_vu_N2.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/P_VU_N2.cpp
+LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/PAR_N2.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/PH_FLASH_N2.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/PS_FLASH_N2.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/PT_FLASH_N2.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/S_VU_N2.cpp
+LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/SBTL_TAB_N2.cpp
+LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/SPLINE_N2.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/T_VU_N2.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/U_VH_N2_INI.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/U_VP_N2.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/U_VT_N2.cpp
+LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/U_VT_N2_INI.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/VU_HP_N2_INI.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/VU_N2.cpp
+LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/VU_N2_N.cpp
+LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/VU_PZ_N2.cpp
+LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/VU_PZ_N2_TAB.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/VU_SH_N2_INI.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/VU_SP_N2_INI.cpp
 LIBSBTL_NITROGEN_srcfiles  += $(LIBSBTL_NITROGEN_DIR)/VU_TP_N2_INI.cpp
@@ -32,19 +43,100 @@ LIBSBTL_NITROGEN_objects   := $(patsubst %.cpp, %.$(obj-suffix), $(LIBSBTL_NITRO
 LIBSBTL_NITROGEN_deps      := $(patsubst %.$(obj-suffix), %.$(obj-suffix).d, $(LIBSBTL_NITROGEN_objects))
 LIBSBTL_NITROGEN_LIB       := $(LIBSBTL_NITROGEN_DIR)/libSBTL_Nitrogen-$(METHOD).la
 
+# The coefficient tables are compiled into the library unless LIBSBTL_NITROGEN_EMBEDDED_TABLES is
+# set to false. Such a build is much faster but needs a table file ('table_file' parameter of
+# NitrogenSBTLFluidProperties), which 'make sbtl_nitrogen_tables' writes from a build with tables.
+LIBSBTL_NITROGEN_EMBEDDED_TABLES ?= true
+LIBSBTL_NITROGEN_TABLES    := $(LIBSBTL_NITROGEN_DIR)/SBTL_N2.tab
+LIBSBTL_NITROGEN_TABLES_EXEC := $(LIBSBTL_NITROGEN_DIR)/tools/sbtl_n2_tables
+
+# shm_open (table sharing through POSIX shared memory) is in librt with glibc before 2.34, the
+# threads of the *_NP functions need libpthread
+LIBSBTL_NITROGEN_LIBS      :=
+ifeq ($(shell uname -s),Linux)
+LIBSBTL_NITROGEN_LIBS      += -lrt -lpthread
+endif
+
+# LIBSBTL_NITROGEN_FLOAT_TABLES=true stores the coefficients as float ('make sbtl_nitrogen_validate'
+# reports the resulting deviations from the double precision tables)
+LIBSBTL_NITROGEN_FLOAT_TABLES ?= false
+LIBSBTL_NITROGEN_VALIDATE_EXEC := $(LIBSBTL_NITROGEN_DIR)/tools/sbtl_n2_validate
+
+# LIBSBTL_NITROGEN_TILED_TABLES=true stores the cells of the forward splines in tiles of 8 x 8 cells
+# instead of row-major, so that steps in u stay close in memory ('make sbtl_nitrogen_bench' compares
+# the layouts)
+LIBSBTL_NITROGEN_TILED_TABLES ?= false
+
+LIBSBTL_NITROGEN_CPPFLAGS  :=
+ifeq ($(LIBSBTL_NITROGEN_EMBEDDED_TABLES),false)
+LIBSBTL_NITROGEN_CPPFLAGS  += -DSBTL_NO_EMBEDDED_TABLES
+endif
+ifeq ($(LIBSBTL_NITROGEN_FLOAT_TABLES),true)
+LIBSBTL_NITROGEN_CPPFLAGS  += -DSBTL_FLOAT_TABLES
+endif
+ifeq ($(LIBSBTL_NITROGEN_TILED_TABLES),true)
+LIBSBTL_NITROGEN_CPPFLAGS  += -DSBTL_TILED_TABLES
+endif
+$(LIBSBTL_NITROGEN_objects): libmesh_CPPFLAGS += $(LIBSBTL_NITROGEN_CPPFLAGS)
+
 app_INCLUDES += -I$(NITROGEN_DIR)
 app_LIBS += $(LIBSBTL_NITROGEN_LIB)
 
 $(LIBSBTL_NITROGEN_LIB): $(LIBSBTL_NITROGEN_objects)
 	@echo "Linking Library "$@"..."
 	@$(libmesh_LIBTOOL) --tag=CC $(LIBTOOLFLAGS) --mode=link --quiet \
-	  $(libmesh_CC) $(libmesh_CFLAGS) -o $@ $(LIBSBTL_NITROGEN_objects) $(libmesh_LDFLAGS) $(EXTERNAL_FLAGS) -rpath $(LIBSBTL_NITROGEN_DIR)
+	  $(libmesh_CC) $(libmesh_CFLAGS) -o $@ $(LIBSBTL_NITROGEN_objects) $(libmesh_LDFLAGS) $(LIBSBTL_NITROGEN_LIBS) $(EXTERNAL_FLAGS) -rpath $(LIBSBTL_NITROGEN_DIR)
 	@$(libmesh_LIBTOOL) --mode=install --quiet install -c $(LIBSBTL_NITROGEN_LIB) $(LIBSBTL_NITROGEN_DIR)
 
 $(app_EXEC): $(LIBSBTL_NITROGEN_LIB)
 
 -include $(LIBSBTL_NITROGEN_deps)
 
+sbtl_nitrogen_tables: $(LIBSBTL_NITROGEN_LIB)
+	@echo "Writing "$(LIBSBTL_NITROGEN_TABLES)"..."
+	@$(libmesh_LIBTOOL) --tag=CXX $(LIBTOOLFLAGS) --mode=link --quiet \
+	  $(libmesh_CXX) $(libmesh_CXXFLAGS) $(LIBSBTL_NITROGEN_CPPFLAGS) -I$(LIBSBTL_NITROGEN_DIR) \
+	  -o $(LIBSBTL_NITROGEN_TABLES_EXEC) \
+	  $(LIBSBTL_NITROGEN_DIR)/tools/SBTL_TAB_N2_WRITE.cpp $(LIBSBTL_NITROGEN_LIB)
+	@$(libmesh_LIBTOOL) --mode=execute $(LIBSBTL_NITROGEN_TABLES_EXEC) $(LIBSBTL_NITROGEN_TABLES)
+
+# sbtl_nitrogen_validate [SBTL_N2_TABLES=<double precision table file>]
+sbtl_nitrogen_validate: $(LIBSBTL_NITROGEN_LIB)
+	@echo "Validating the libSBTL_Nitrogen tables..."
+	@$(libmesh_LIBTOOL) --tag=CXX $(LIBTOOLFLAGS) --mode=link --quiet \
+	  $(libmesh_CXX) $(libmesh_CXXFLAGS) $(LIBSBTL_NITROGEN_CPPFLAGS) -I$(LIBSBTL_NITROGEN_DIR) \
+	  -o $(LIBSBTL_NITROGEN_VALIDATE_EXEC) \
+	  $(LIBSBTL_NITROGEN_DIR)/tools/SBTL_TAB_N2_VALIDATE.cpp $(LIBSBTL_NITROGEN_LIB)
+	@$(libmesh_LIBTOOL) --mode=execute $(LIBSBTL_NITROGEN_VALIDATE_EXEC) $(SBTL_N2_TABLES)
+
+# sbtl_nitrogen_bench [SBTL_N2_BENCH_ARGS="<points per distribution> <repetitions>"]
+LIBSBTL_NITROGEN_BENCH_EXEC := $(LIBSBTL_NITROGEN_DIR)/sbtl_n2_bench-$(METHOD)
+sbtl_nitrogen_bench: $(LIBSBTL_NITROGEN_LIB)
+	@echo "Linking Executable "$(LIBSBTL_NITROGEN_BENCH_EXEC)"..."
+	@$(libmesh_LIBTOOL) --tag=CXX $(LIBTOOLFLAGS) --mode=link --quiet \
+	  $(libmesh_CXX) $(libmesh_CXXFLAGS) $(LIBSBTL_NITROGEN_CPPFLAGS) -I$(LIBSBTL_NITROGEN_DIR) \
+	  -o $(LIBSBTL_NITROGEN_BENCH_EXEC) \
+	  $(LIBSBTL_NITROGEN_DIR)/tools/SBTL_N2_BENCH.cpp $(LIBSBTL_NITROGEN_LIB)
+	@$(libmesh_LIBTOOL) --mode=execute $(LIBSBTL_NITROGEN_BENCH_EXEC) $(SBTL_N2_BENCH_ARGS)
+
+# sbtl_nitrogen_gen [SBTL_N2_GEN_ARGS="UVTN2I <nodes in vt> <nodes in t> |
+#   UVHN2 <nodes in vt for v < 0.01> <nodes in vt for v > 0.01> <nodes in h> |
+#   VUPZN2 <nodes in p> <nodes in z> | tables <table file> | report [<table file>]"]
+# runs in the library directory and writes U_VT_N2_INI.h/.cpp, U_VH_N2_INI.h/.cpp or
+# VU_PZ_N2_TAB.h/.cpp with the given grid there (rebuild the library and the table file
+# afterwards); tables writes a table file of all splines fitted to the reference equations, report
+# lists the accuracy of all splines
+SBTL_N2_GEN_ARGS ?= report
+LIBSBTL_NITROGEN_GEN_EXEC := $(LIBSBTL_NITROGEN_DIR)/tools/sbtl_n2_gen
+sbtl_nitrogen_gen: $(LIBSBTL_NITROGEN_LIB)
+	@echo "Linking Executable "$(LIBSBTL_NITROGEN_GEN_EXEC)"..."
+	@$(libmesh_LIBTOOL) --tag=CXX $(LIBTOOLFLAGS) --mode=link --quiet \
+	  $(libmesh_CXX) $(libmesh_CXXFLAGS) $(LIBSBTL_NITROGEN_CPPFLAGS) -I$(LIBSBTL_NITROGEN_DIR) \
+	  -o $(LIBSBTL_NITROGEN_GEN_EXEC) \
+	  $(LIBSBTL_NITROGEN_DIR)/tools/SBTL_N2_GEN.cpp $(LIBSBTL_NITROGEN_LIB)
+	@cd $(LIBSBTL_NITROGEN_DIR) && $(libmesh_LIBTOOL) --mode=execute $(LIBSBTL_NITROGEN_GEN_EXEC) \
+	  $(SBTL_N2_GEN_ARGS)
+
 cleanlibsbtl_nitrogen:
 	@echo "Cleaning libSBTL_Nitrogen"
 	@rm -f $(LIBSBTL_NITROGEN_objects)
@@ -53,3 +145,7 @@ cleanlibsbtl_nitrogen:
 	@rm -f $(LIBSBTL_NITROGEN_DIR)/libSBTL_Nitrogen-$(METHOD)*.dylib
 	@rm -f $(LIBSBTL_NITROGEN_DIR)/libSBTL_Nitrogen-$(METHOD)*.so*
 	@rm -f $(LIBSBTL_NITROGEN_DIR)/libSBTL_Nitrogen-$(METHOD)*.a
+	@rm -f $(LIBSBTL_NITROGEN_TABLES_EXEC)
+	@rm -f $(LIBSBTL_NITROGEN_VALIDATE_EXEC)
+	@rm -f $(LIBSBTL_NITROGEN_BENCH_EXEC)
+	@rm -f $(LIBSBTL_NITROGEN_GEN_EXEC)
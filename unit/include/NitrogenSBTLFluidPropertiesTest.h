@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "MooseObjectUnitTest.h"
 #include "NitrogenSBTLFluidProperties.h"
 
@@ -18,11 +20,30 @@ public:
   NitrogenSBTLFluidPropertiesTest() : MooseObjectUnitTest("NitrogenApp") { buildObjects(); }
 
 protected:
-  void buildObjects()
+  void buildObjects() { _fp = &addFluidProperties("fp"); }
+
+  /// Adds a fluid properties object with the default parameters, changed by set_params if given
+  const NitrogenSBTLFluidProperties &
+  addFluidProperties(const std::string & name,
+                     const std::function<void(InputParameters &)> & set_params = nullptr)
   {
     InputParameters uo_pars = _factory.getValidParams("NitrogenSBTLFluidProperties");
-    _fe_problem->addUserObject("NitrogenSBTLFluidProperties", "fp", uo_pars);
-    _fp = &_fe_problem->getUserObject<NitrogenSBTLFluidProperties>("fp");
+    if (set_params)
+      set_params(uo_pars);
+    _fe_problem->addUserObject("NitrogenSBTLFluidProperties", name, uo_pars);
+    return _fe_problem->getUserObject<NitrogenSBTLFluidProperties>(name);
+  }
+
+  /// Parameters of instrumented flashes with the given tolerance and without the flash cache, so
+  /// that the statistics count the flashes from the backward splines
+  static std::function<void(InputParameters &)> instrumented(const std::string & tolerance)
+  {
+    return [tolerance](InputParameters & pars)
+    {
+      pars.set<bool>("instrument_flashes") = true;
+      pars.set<bool>("use_flash_cache") = false;
+      pars.set<MooseEnum>("flash_tolerance") = tolerance;
+    };
   }
 
   const NitrogenSBTLFluidProperties * _fp;